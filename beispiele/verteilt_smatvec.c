@@ -0,0 +1,151 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+/* Vergleicht das verteilte Matrix-Vektor Produkt mit joelix_smatvec.
+   Jeder Rang baut zusaetzlich die ganze Matrix auf und prueft seine Zeilen
+   des Ergebnisses. Uebersetzen und starten mit
+
+     make MPI=1 beispiele
+     mpirun -np 4 ./build/beispiele/verteilt_smatvec
+
+   Der Rueckgabewert ist 0, wenn alle Raenge uebereinstimmen. */
+
+#include <stdio.h>
+#include <math.h>
+#include <mpi.h>
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+#include "verteilt.h"
+
+#define N 1000
+#define MAX_ZEILE 7
+
+/* Zeile i der Matrix: Nachbarn im Abstand 1 und 17 und eine Kopplung an
+   die gegenueberliegende Zeile, so dass jeder Rang mit fast allen anderen
+   Raengen Eintraege austauscht */
+static int joelix_beispiel_zeile (int i, double *werte, int *spalten)
+{
+  int abstaende[3] = {1, 17, N / 2}, d, k = 0;
+
+  werte[k] = 4;
+  spalten[k++] = i;
+  for (d = 0;d < 3;d++) {
+    if (i - abstaende[d] >= 0) {
+      werte[k] = -1.0 / (d + 1);
+      spalten[k++] = i - abstaende[d];
+    }
+    if (i + abstaende[d] < N && abstaende[d] != N / 2) {
+      werte[k] = -1.0 / (d + 1);
+      spalten[k++] = i + abstaende[d];
+    }
+  }
+  return k;
+}
+
+/* Baut die Zeilen anfang <= i < anfang + nlokal der verteilten Matrix auf.
+   Mit nnichtnull_extra > 0 werden mehr Eintraege angekuendigt als befuellt. */
+static Joelix_Fehler joelix_beispiel_aufbauen (Joelix_vsMatrix *pM, int anfang, int nlokal,
+                                               int nnichtnull_extra)
+{
+  double werte[MAX_ZEILE];
+  int spalten[MAX_ZEILE], i, k, nnE = 0;
+  Joelix_Fehler fehler;
+
+  for (i = anfang;i < anfang + nlokal;i++) nnE += joelix_beispiel_zeile (i, werte, spalten);
+  if (joelix_vsmatrix_init (pM, MPI_COMM_WORLD, N, nlokal, nnE + nnichtnull_extra) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  for (i = anfang;i < anfang + nlokal;i++) {
+    k = joelix_beispiel_zeile (i, werte, spalten);
+    if (joelix_vsmatrix_fuelleZeile (*pM, i, k, werte, spalten) != F_ERFOLG) return joelix_fehler_code;
+  }
+  fehler = joelix_vsmatrix_aufbauen (*pM);
+  if (fehler != F_ERFOLG) joelix_vsmatrix_loeschen (pM);
+  return fehler;
+}
+
+int main (int argc, char **argv)
+{
+  Joelix_vsMatrix V;
+  Joelix_sMatrix M;
+  Joelix_vVektor vx, vb;
+  Joelix_Vektor x, b;
+  double werte[MAX_ZEILE], wert, fehler_lokal = 0, fehler_global;
+  int spalten[MAX_ZEILE], i, k, nnE = 0, rang, nraenge, anfang, nlokal, code, code_max, code_min;
+
+  MPI_Init (&argc, &argv);
+  MPI_Comm_rank (MPI_COMM_WORLD, &rang);
+  MPI_Comm_size (MPI_COMM_WORLD, &nraenge);
+  joelix_vvektor_init (&vx, MPI_COMM_WORLD, N, -1);
+  joelix_vvektor_init (&vb, MPI_COMM_WORLD, N, -1);
+  anfang = joelix_vvektor_anfang (vx);
+  nlokal = joelix_vektor_laenge (joelix_vvektor_lokal (vx));
+
+  /* Ein Rang kuendigt mehr Eintraege an, als er befuellt. Alle Raenge
+     muessen denselben Fehler bekommen, statt aufeinander zu warten. */
+  code = joelix_beispiel_aufbauen (&V, anfang, nlokal, rang == nraenge - 1 ? 1 : 0);
+  MPI_Allreduce (&code, &code_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce (&code, &code_min, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (rang == 0) {
+    printf ("Fehlerfall: %s (auf allen Raengen gleich: %s)\n",
+            joelix_fehler_beschreibung (code), code_max == code_min ? "ja" : "nein");
+  }
+
+  /* Die richtige verteilte Matrix */
+  if (joelix_beispiel_aufbauen (&V, anfang, nlokal, 0) != F_ERFOLG) MPI_Abort (MPI_COMM_WORLD, 1);
+  for (i = 0;i < nlokal;i++) {
+    joelix_vektor_seti (joelix_vvektor_lokal (vx), i, sin (0.1 * (anfang + i)));
+  }
+  if (joelix_vsmatvec (vb, V, vx) != F_ERFOLG) MPI_Abort (MPI_COMM_WORLD, 1);
+
+  /* Dieselbe Matrix seriell */
+  for (i = 0;i < N;i++) nnE += joelix_beispiel_zeile (i, werte, spalten);
+  joelix_smatrix_init (&M, N, N, nnE);
+  for (i = 0;i < N;i++) {
+    k = joelix_beispiel_zeile (i, werte, spalten);
+    joelix_smatrix_fuelleZeile (M, i, k, werte, spalten);
+  }
+  joelix_vektor_init (&x, N);
+  joelix_vektor_init (&b, N);
+  for (i = 0;i < N;i++) joelix_vektor_seti (x, i, sin (0.1 * i));
+  joelix_smatvec (b, M, x);
+
+  for (i = 0;i < nlokal;i++) {
+    joelix_vektor_geti (joelix_vvektor_lokal (vb), i, &wert);
+    joelix_vektor_geti (b, anfang + i, &werte[0]);
+    if (fabs (wert - werte[0]) > fehler_lokal) fehler_lokal = fabs (wert - werte[0]);
+  }
+  MPI_Allreduce (&fehler_lokal, &fehler_global, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  if (rang == 0) printf ("%d Raenge, groesste Abweichung: %g\n", nraenge, fehler_global);
+
+  joelix_vektor_loeschen (&x);
+  joelix_vektor_loeschen (&b);
+  joelix_smatrix_loeschen (&M);
+  joelix_vvektor_loeschen (&vx);
+  joelix_vvektor_loeschen (&vb);
+  joelix_vsmatrix_loeschen (&V);
+  MPI_Finalize ();
+  return (fehler_global < 1e-12 && code_max == code_min && code != F_ERFOLG) ? 0 : 1;
+}
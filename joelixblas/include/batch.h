@@ -0,0 +1,195 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_BATCH_H__
+#define __JOELIX_BATCH_H__
+
+#include "joelix_error.h"
+#include "kontext.h"
+
+/** \file batch.h Hier werden die Funktionen fuer viele kleine, voneinander
+  unabhaengige sparse Systeme festgelegt. Eine Batch speichert alle Matrizen
+  in einem zusammenhaengenden Speicherbereich. Haben alle Systeme dasselbe
+  Muster, wird das Muster nur einmal gespeichert und die Werte von je 8
+  Systemen werden verschraenkt, so dass die Rechnungen fuer 8 Systeme
+  gleichzeitig in den SIMD Registern laufen.
+  Die Rechenfunktionen pruefen ihre Argumente einmal fuer die ganze Batch
+  und setzen joelix_fehler_code nur einmal. */
+
+/** Der Datentyp fuer eine Batch von sparse Matrizen. */
+typedef struct Joelix_Batch_t * Joelix_Batch;
+
+/** Der Datentyp fuer die Vektoren zu einer Batch, ein Vektor pro System. */
+typedef struct Joelix_Batch_Vektor_t * Joelix_Batch_Vektor;
+
+/** Initialisiert eine Batch von nsys n x n Matrizen, die alle dasselbe Muster
+   haben. Alle Werte sind danach 0.
+   \param [in,out] pBatch Pointer auf die Batch.
+   \param [in] nsys        Die Anzahl der Systeme.
+   \param [in] n           Die Zeilen- und Spaltenanzahl jedes Systems.
+   \param [in] nnE         Die Anzahl der nicht-null Eintraege jedes Systems.
+   \param [in] zeilen_akk  Array der Laenge n+1 wie in der CSR Darstellung von
+                           Joelix_sMatrix (zeilen_akk[0] = 0, zeilen_akk[n] = nnE).
+   \param [in] spalten_ind Array der Laenge nnE mit den Spaltenindices.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_init_muster (Joelix_Batch *pBatch, int nsys, int n, int nnE,
+                                        const int *zeilen_akk, const int *spalten_ind);
+
+/** Initialisiert eine Batch von nsys Matrizen mit verschiedenen Mustern.
+   Die Muster werden danach mit joelix_batch_setze_system gesetzt.
+   \param [in,out] pBatch Pointer auf die Batch.
+   \param [in] nsys        Die Anzahl der Systeme.
+   \param [in] n           Array der Laenge nsys. System s ist eine n[s] x n[s] Matrix.
+   \param [in] nnE         Array der Laenge nsys. System s hat nnE[s] nicht-null Eintraege.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_init (Joelix_Batch *pBatch, int nsys, const int *n, const int *nnE);
+
+/** Setze Muster und Werte eines Systems einer mit joelix_batch_init
+   initialisierten Batch.
+   \param [in,out] B       Die Batch.
+   \param [in] s           Das System, 0 <= s < nsys.
+   \param [in] zeilen_akk  Array der Laenge n[s]+1 (CSR).
+   \param [in] spalten_ind Array der Laenge nnE[s].
+   \param [in] werte       Array der Laenge nnE[s].
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_setze_system (Joelix_Batch B, int s, const int *zeilen_akk,
+                                         const int *spalten_ind, const double *werte);
+
+/** Setze die Werte eines Systems, das Muster bleibt gleich. Damit koennen
+   z.B. in jedem Zeitschritt neue Werte eingetragen werden.
+   \param [in,out] B       Die Batch.
+   \param [in] s           Das System, 0 <= s < nsys.
+   \param [in] werte       Array mit nnE Werten in der Reihenfolge von spalten_ind.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_setze_werte (Joelix_Batch B, int s, const double *werte);
+
+/** Gebe die Anzahl der Systeme einer Batch aus.
+   \param [in] B      Eine initialisierte Batch.
+   \return        Die Anzahl der Systeme oder -1 bei Fehler.
+ */
+int joelix_batch_systeme (Joelix_Batch B);
+
+/** Gibt den Speicher einer Batch wieder frei.
+   \param [in,out] pBatch Pointer auf eine initialisierte Batch.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_loeschen (Joelix_Batch *pBatch);
+
+/** Initialisiert die Vektoren zu einer Batch mit Nullen, fuer jedes System
+   einen Vektor passender Laenge. Die Speicheranordnung passt zu B, der
+   Vektor kann also mit allen Batches gleicher Groesse und Art benutzt werden.
+   \param [in,out] pVektor Pointer auf den Batch-Vektor.
+   \param [in] B          Eine initialisierte Batch.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_init (Joelix_Batch_Vektor *pVektor, Joelix_Batch B);
+
+/** Setze alle Eintraege aller Systeme auf 0.
+   \param [in,out] x      Ein initialisierter Batch-Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_null (Joelix_Batch_Vektor x);
+
+/** Setze Eintrag i des Vektors von System s.
+   \param [in,out] x      Ein initialisierter Batch-Vektor.
+   \param [in] s          Das System.
+   \param [in] i          Der Index innerhalb des Systems.
+   \param [in] wert       Der neue Wert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_seti (Joelix_Batch_Vektor x, int s, int i, double wert);
+
+/** Lese Eintrag i des Vektors von System s.
+   \param [in] x          Ein initialisierter Batch-Vektor.
+   \param [in] s          Das System.
+   \param [in] i          Der Index innerhalb des Systems.
+   \param [out] wert      Pointer auf einen double fuer den Wert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_geti (Joelix_Batch_Vektor x, int s, int i, double *wert);
+
+/** Kopiere den ganzen Vektor eines Systems in den Batch-Vektor.
+   \param [in,out] x      Ein initialisierter Batch-Vektor.
+   \param [in] s          Das System.
+   \param [in] werte      Array mit so vielen Werten, wie System s Zeilen hat.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_setze_system (Joelix_Batch_Vektor x, int s,
+                                                const double *werte);
+
+/** Kopiere den Vektor eines Systems aus dem Batch-Vektor heraus.
+   \param [in] x          Ein initialisierter Batch-Vektor.
+   \param [in] s          Das System.
+   \param [out] werte     Array mit Platz fuer so viele Werte, wie System s
+                          Zeilen hat.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_hole_system (Joelix_Batch_Vektor x, int s, double *werte);
+
+/** Gibt den Speicher eines Batch-Vektors wieder frei.
+   \param [in,out] pVektor Pointer auf einen initialisierten Batch-Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_vektor_loeschen (Joelix_Batch_Vektor *pVektor);
+
+/** Berechnet y_s = B_s x_s fuer alle Systeme s.
+   \param [out] y         Ein zu B passender Batch-Vektor.
+   \param [in] B          Eine initialisierte Batch.
+   \param [in] x          Ein zu B passender Batch-Vektor, nicht y.
+   \param [in] K          Ein Kontext oder NULL. Mit K werden die Systeme auf
+                          die Threads von K verteilt.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_smatvec (Joelix_Batch_Vektor y, Joelix_Batch B, Joelix_Batch_Vektor x,
+                                    Joelix_Kontext K);
+
+/** Loest B_s x_s = b_s fuer alle Systeme s mit dem CG-Verfahren. Alle
+   Matrizen muessen symmetrisch positiv definit sein.
+   Jedes System (bzw. jeder Block von 8 Systemen mit gemeinsamem Muster)
+   wird von einem Thread bis zur Konvergenz geloest. Die Threads holen sich
+   die Systeme einzeln ab, so dass schnell konvergierende Systeme keinen
+   Thread blockieren. Innerhalb eines Blocks rechnen konvergierte Systeme
+   nicht mehr weiter.
+   \param [in] B          Eine initialisierte Batch.
+   \param [in] b          Die rechten Seiten.
+   \param [in,out] x      Die Startwerte, danach die Loesungen.
+   \param [in] tol        System s ist konvergiert, wenn |b_s - B_s x_s| <= tol |b_s|.
+   \param [in] maxiter    Die maximale Anzahl an Iterationen pro System.
+   \param [in] K          Ein Kontext oder NULL.
+   \param [out] konvergiert Array der Laenge nsys oder NULL. An Stelle s steht
+                          danach 1, wenn System s konvergiert ist, sonst 0.
+   \param [out] iterationen Array der Laenge nsys oder NULL. Die Anzahl der
+                          Iterationen von System s.
+   \return        F_ERFOLG, wenn alle Systeme konvergiert sind,
+                  F_CG_TERMINIERT_NICHT, wenn nicht, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_batch_cg (Joelix_Batch B, Joelix_Batch_Vektor b, Joelix_Batch_Vektor x,
+                               double tol, int maxiter, Joelix_Kontext K, int *konvergiert,
+                               int *iterationen);
+
+#endif
@@ -0,0 +1,128 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_DATEI_H__
+#define __JOELIX_DATEI_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+
+/** \file datei.h Hier werden die Funktionen zum Schreiben und Lesen von
+  Vektoren und von Checkpoints festgelegt.
+
+  Das Binaerformat besteht aus einem Kopf von 64 Byte (Kennung, Version,
+  Bytereihenfolge, Laenge, Pruefsumme) und danach den Eintraegen als double
+  in der Bytereihenfolge des Rechners, der die Datei geschrieben hat. Eine
+  Datei mit anderer Bytereihenfolge wird mit F_DATEI_FORMAT abgelehnt. */
+
+/** Flags fuer joelix_vektor_lesen, koennen mit | kombiniert werden. */
+typedef enum {
+  JOELIX_DATEI_KOPIE = 0,      /**< Die Eintraege werden in neuen Speicher
+                                    gelesen. */
+  JOELIX_DATEI_ABBILDEN = 1,   /**< Die Datei wird mit mmap (MAP_PRIVATE)
+                                    abgebildet. Aenderungen am Vektor landen
+                                    nicht in der Datei. */
+  JOELIX_DATEI_UNGEPRUEFT = 2  /**< Die Pruefsumme wird nicht berechnet. Mit
+                                    JOELIX_DATEI_ABBILDEN werden dann nur die
+                                    Seiten gelesen, die benutzt werden. */
+} Joelix_Datei_Flags;
+
+/** Schreibe einen Vektor im Binaerformat in eine Datei.
+   \param [in] x          Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] dateiname  Der Name der Datei. Die Datei wird ueberschrieben,
+                          falls sie existiert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_schreiben (Joelix_Vektor x, const char *dateiname);
+
+/** Lese einen Vektor, der mit joelix_vektor_schreiben geschrieben wurde.
+   Der Vektor wird wie mit joelix_vektor_init angelegt und muss mit
+   joelix_vektor_loeschen wieder freigegeben werden.
+   \param [out] pVektor   Pointer auf den neuen Vektor.
+   \param [in] dateiname  Der Name der Datei.
+   \param [in] flags      Eine Kombination von Joelix_Datei_Flags.
+   \return        F_ERFOLG bei Erfolg, F_DATEI_FORMAT, wenn Kopf oder
+                  Pruefsumme nicht stimmen, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_lesen (Joelix_Vektor *pVektor, const char *dateiname, int flags);
+
+/** Schreibe einen Vektor als Text in eine Datei, ein Eintrag pro Zeile.
+   Jeder Eintrag wird mit so wenigen Stellen wie moeglich geschrieben, aber
+   so, dass joelix_vektor_text_lesen wieder genau denselben Wert ergibt.
+   \param [in] x          Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] dateiname  Der Name der Datei. Die Datei wird ueberschrieben,
+                          falls sie existiert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_text_schreiben (Joelix_Vektor x, const char *dateiname);
+
+/** Lese einen Vektor aus einer Textdatei. Aus jeder Zeile wird die letzte
+   Zahl gelesen, leere Zeilen und Zeilen, die mit # anfangen, werden
+   uebersprungen. Damit koennen Dateien von joelix_vektor_text_schreiben und
+   joelix_vektor_print_tofile gelesen werden.
+   \param [out] pVektor   Pointer auf den neuen Vektor.
+   \param [in] dateiname  Der Name der Datei.
+   \return        F_ERFOLG bei Erfolg, F_DATEI_FORMAT, wenn eine Zeile keine
+                  Zahl enthaelt, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_text_lesen (Joelix_Vektor *pVektor, const char *dateiname);
+
+/** Speichere den Zustand eines iterativen Verfahrens, damit es spaeter mit
+   joelix_checkpoint_lesen fortgesetzt werden kann, z.B. die Iterationszahl,
+   die Naeherung, das Residuum und die Suchrichtung beim CG-Verfahren und
+   Skalare wie das letzte r*r.
+   Die Datei wird erst unter dateiname.tmp geschrieben und dann umbenannt,
+   bei einem Abbruch waehrend des Schreibens bleibt also der letzte
+   Checkpoint erhalten.
+   \param [in] dateiname  Der Name der Datei.
+   \param [in] iteration  Die Iterationszahl.
+   \param [in] vektoren   Ein Array von nvek initialisierten Vektoren.
+   \param [in] nvek       Die Anzahl der Vektoren, nvek >= 0.
+   \param [in] skalare    Ein Array von nskalare Werten oder NULL.
+   \param [in] nskalare   Die Anzahl der Skalare, nskalare >= 0.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_checkpoint_schreiben (const char *dateiname, long iteration,
+                                           Joelix_Vektor *vektoren, int nvek,
+                                           const double *skalare, int nskalare);
+
+/** Lese einen mit joelix_checkpoint_schreiben gespeicherten Zustand.
+   Anzahl und Laengen der Vektoren und die Anzahl der Skalare muessen mit
+   dem Checkpoint uebereinstimmen. Bei F_DATEI_FORMAT wegen einer falschen
+   Pruefsumme koennen die Vektoren schon teilweise ueberschrieben sein.
+   \param [in] dateiname  Der Name der Datei.
+   \param [out] iteration Die gespeicherte Iterationszahl.
+   \param [in,out] vektoren Ein Array von nvek initialisierten Vektoren.
+   \param [in] nvek       Die Anzahl der Vektoren.
+   \param [out] skalare   Ein Array von nskalare Werten oder NULL.
+   \param [in] nskalare   Die Anzahl der Skalare.
+   \return        F_ERFOLG bei Erfolg, F_FILEIO_FEHLER, wenn die Datei nicht
+                  existiert, F_DATEI_FORMAT, wenn die Datei nicht passt oder
+                  beschaedigt ist, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_checkpoint_lesen (const char *dateiname, long *iteration,
+                                       Joelix_Vektor *vektoren, int nvek,
+                                       double *skalare, int nskalare);
+
+#endif
@@ -0,0 +1,177 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_DMATRIX_H__
+#define __JOELIX_DMATRIX_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+#include "operator.h"
+
+/** \file dmatrix.h Hier werden sparse Matrizen festgelegt, die nur in einer
+  Datei stehen und nicht in den Speicher passen muessen (Datei-Matrizen).
+  Die Datei ist in Bloecke von Zeilen eingeteilt, jeder Block ist eine
+  kleine CSR Matrix. Beim Matrix-Vektor Produkt liest ein eigener Thread den
+  naechsten Block, waehrend der vorige gerechnet wird, so dass im Speicher
+  immer nur zwei Bloecke liegen. Die Vektoren muessen in den Speicher passen.
+
+  Das Format besteht aus dem Kopf von datei.h, den Bloecken und am Ende
+  einer Tabelle mit Lage und Pruefsumme jedes Blocks. Ein Block enthaelt
+  die Werte (double), die Spaltenindices und die Zeilenanfaenge relativ zum
+  Block (int), aufgefuellt auf ein Vielfaches von 8 Byte. */
+
+/** Der Datentyp fuer eine Datei-Matrix. */
+typedef struct Joelix_dMatrix_t * Joelix_dMatrix;
+
+/** Der Datentyp zum Schreiben einer Datei-Matrix. */
+typedef struct Joelix_dMatrix_Schreiber_t * Joelix_dMatrix_Schreiber;
+
+/** Die Zaehler einer Datei-Matrix, seit dem Oeffnen oder dem letzten
+   joelix_dmatrix_statistik_zuruecksetzen. Ist warte_zeit gross gegen
+   rechen_zeit, begrenzt die Platte das Produkt. Groessere Bloecke helfen
+   dann nur, wenn lese_zeit pro Byte damit sinkt. */
+typedef struct {
+  long produkte;      /**< Anzahl der Durchlaeufe durch die Datei */
+  long bloecke;       /**< Anzahl der gelesenen Bloecke */
+  double bytes;       /**< Gelesene Bytes */
+  double lese_zeit;   /**< Sekunden, die der Lesethread mit pread verbracht hat */
+  double warte_zeit;  /**< Sekunden, die die Rechnung auf Bloecke gewartet hat */
+  double rechen_zeit; /**< Sekunden, die mit Rechnen verbracht wurden */
+} Joelix_dMatrix_Statistik;
+
+/** Beginnt eine neue Datei-Matrix. Die Zeilen werden danach mit
+   joelix_dmatrix_schreiber_zeile uebergeben, im Speicher steht dabei immer
+   nur ein Block.
+   \param [in,out] pSchreiber Pointer auf den Schreiber.
+   \param [in] dateiname  Der Name der Datei. Die Datei wird ueberschrieben,
+                          falls sie existiert.
+   \param [in] nzeilen    Die Anzahl der Zeilen der Matrix.
+   \param [in] nspalten   Die Anzahl der Spalten der Matrix.
+   \param [in] zeilen_pro_block Die Anzahl der Zeilen eines Blocks. Ein Block
+                          sollte einige MB gross sein. Groessere Werte als
+                          nzeilen werden auf nzeilen begrenzt.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_schreiber_init (Joelix_dMatrix_Schreiber *pSchreiber,
+                                             const char *dateiname, int nzeilen, int nspalten,
+                                             int zeilen_pro_block);
+
+/** Schreibt eine Zeile. Wie bei joelix_smatrix_fuelleZeile muessen die
+   Zeilen in aufsteigender Reihenfolge uebergeben werden, Nullzeilen koennen
+   uebersprungen werden.
+   \param [in,out] S      Ein initialisierter Schreiber.
+   \param [in] zeile      Der Index der Zeile.
+   \param [in] znichtnull Die Anzahl der nicht-null Eintraege der Zeile.
+   \param [in] werte      Array der Laenge znichtnull mit den Werten.
+   \param [in] spalten    Array der Laenge znichtnull mit den Spaltenindices.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_schreiber_zeile (Joelix_dMatrix_Schreiber S, int zeile,
+                                              int znichtnull, const double *werte,
+                                              const int *spalten);
+
+/** Schreibt den letzten Block, die Tabelle und den Kopf, schliesst die Datei
+   und gibt den Schreiber frei. Erst danach ist die Datei gueltig.
+   \param [in,out] pSchreiber Pointer auf einen initialisierten Schreiber.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode. Auch bei
+                  einem Fehler ist der Schreiber danach freigegeben.
+ */
+Joelix_Fehler joelix_dmatrix_schreiber_beenden (Joelix_dMatrix_Schreiber *pSchreiber);
+
+/** Schreibt eine vollstaendig befuellte Matrix als Datei-Matrix.
+   \param [in] dateiname  Der Name der Datei.
+   \param [in] M          Eine vollstaendig befuellte Matrix.
+   \param [in] zeilen_pro_block Die Anzahl der Zeilen eines Blocks.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode. Bei
+                  einem Fehler wird die Datei wieder geloescht.
+ */
+Joelix_Fehler joelix_dmatrix_schreiben (const char *dateiname, Joelix_sMatrix M,
+                                        int zeilen_pro_block);
+
+/** Oeffnet eine Datei-Matrix. Gelesen werden nur Kopf und Tabelle.
+   \param [in,out] pMatrix Pointer auf die Matrix.
+   \param [in] dateiname  Der Name der Datei.
+   \param [in] flags      Von den Joelix_Datei_Flags wird nur
+                          JOELIX_DATEI_UNGEPRUEFT beachtet. Ohne das Flag
+                          prueft der Lesethread die Pruefsumme jedes Blocks.
+   \return        F_ERFOLG bei Erfolg, F_DATEI_FORMAT, wenn Kopf oder
+                  Tabelle nicht stimmen, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_oeffnen (Joelix_dMatrix *pMatrix, const char *dateiname,
+                                      int flags);
+
+/** Gebe die Anzahl der Zeilen einer Datei-Matrix aus.
+   \param [in] A      Eine geoeffnete Datei-Matrix.
+   \return        Die Anzahl der Zeilen oder -1 bei Fehler.
+ */
+int joelix_dmatrix_zeilen (Joelix_dMatrix A);
+
+/** Gebe die Anzahl der Spalten einer Datei-Matrix aus.
+   \param [in] A      Eine geoeffnete Datei-Matrix.
+   \return        Die Anzahl der Spalten oder -1 bei Fehler.
+ */
+int joelix_dmatrix_spalten (Joelix_dMatrix A);
+
+/** Berechnet b = Ax mit einem Durchlauf durch die Datei.
+   \param [out] b     Ein Vektor der Laenge n (Zeilen von A), nicht x.
+   \param [in] A      Eine geoeffnete Datei-Matrix.
+   \param [in] x      Ein Vektor der Laenge m (Spalten von A).
+   \return        F_ERFOLG bei Erfolg, F_FILEIO_FEHLER oder F_DATEI_FORMAT,
+                  wenn ein Block nicht gelesen werden konnte oder sein
+                  Inhalt nicht stimmt, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_smatvec (Joelix_Vektor b, Joelix_dMatrix A, Joelix_Vektor x);
+
+/** Erstellt einen Operator fuer eine Datei-Matrix, so dass sie ueberall
+   benutzt werden kann, wo ein Joelix_Operator erwartet wird. Mehrere
+   Vektoren auf einmal (z.B. in joelix_eigen_lobpcg_op) werden mit einem
+   einzigen Durchlauf durch die Datei multipliziert. A muss laenger
+   existieren als der Operator.
+   \param [in,out] pOperator Pointer auf den Operator.
+   \param [in] A          Eine geoeffnete Datei-Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_operator (Joelix_Operator *pOperator, Joelix_dMatrix A);
+
+/** Gebe die Zaehler einer Datei-Matrix aus.
+   \param [in] A      Eine geoeffnete Datei-Matrix.
+   \param [out] statistik Pointer auf die Zaehler.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_statistik (Joelix_dMatrix A, Joelix_dMatrix_Statistik *statistik);
+
+/** Setzt die Zaehler einer Datei-Matrix auf 0.
+   \param [in,out] A  Eine geoeffnete Datei-Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_statistik_zuruecksetzen (Joelix_dMatrix A);
+
+/** Schliesst die Datei und gibt den Speicher wieder frei.
+   \param [in,out] pMatrix Pointer auf eine geoeffnete Datei-Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_dmatrix_schliessen (Joelix_dMatrix *pMatrix);
+
+#endif
@@ -0,0 +1,122 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_EIGEN_H__
+#define __JOELIX_EIGEN_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+#include "operator.h"
+
+/** \file eigen.h Hier werden die Eigenwertloeser fuer symmetrische sparse
+  Matrizen festgelegt. Beide Verfahren berechnen die k kleinsten Eigenwerte
+  und die zugehoerigen Eigenvektoren. Der Speicherbedarf ist ein kleines
+  Vielfaches von k mal Matrixgroesse. */
+
+/** Ein Vorkonditionierer fuer joelix_eigen_lobpcg. Berechnet Y = T R fuer
+   nvek Vektoren auf einmal. R und Y sind zeilenweise gespeichert, d.h.
+   Eintrag i von Vektor v steht an Stelle i*nvek+v.
+   \param [out] Y     Array der Laenge n*nvek fuer das Ergebnis.
+   \param [in] R      Array der Laenge n*nvek mit den Residuen.
+   \param [in] n      Die Laenge der Vektoren.
+   \param [in] nvek   Die Anzahl der Vektoren.
+   \param [in] daten  Der Pointer, der joelix_eigen_lobpcg uebergeben wurde.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+typedef Joelix_Fehler (*Joelix_Vorkonditionierer) (double *Y, const double *R, int n, int nvek,
+                                                   void *daten);
+
+/** Berechnet die k kleinsten Eigenwerte einer symmetrischen Matrix mit dem
+   Lanczos-Verfahren mit dickem Neustart. Die Lanczos-Basis wird in jedem
+   Schritt vollstaendig reorthogonalisiert (klassisches Gram-Schmidt,
+   zweimal). Beim Neustart werden etwa k + (m-k)/2 Ritzvektoren behalten,
+   wobei die Basis m = max (2k, k+20) Vektoren hat.
+   \param [in] A       Eine symmetrische quadratische Matrix.
+   \param [in] k       Die Anzahl der gesuchten Eigenwerte, 1 <= k <= n.
+   \param [in] tol     Die Toleranz. Ein Eigenpaar (lambda, x) ist
+                       konvergiert, wenn |Ax - lambda x| <= tol |lambda|.
+   \param [in] maxiter Die maximale Anzahl an Neustarts.
+   \param [out] eigenwerte Ein Array der Laenge k, aufsteigend sortiert.
+   \param [in,out] eigenvektoren Ein Array von k Vektoren der Laenge n. Ist
+                       eigenvektoren[0] nicht null, wird er als Startvektor
+                       benutzt. Danach stehen hier die Eigenvektoren.
+   \param [out] iterationen Die Anzahl der Neustarts, oder NULL.
+   \return             F_ERFOLG bei Erfolg, F_EIGEN_TERMINIERT_NICHT, falls
+                       die Toleranz nicht erreicht wurde (die Naeherungen
+                       stehen trotzdem in eigenwerte und eigenvektoren),
+                       sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_eigen_lanczos (Joelix_sMatrix A, int k, double tol, int maxiter,
+                                    double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                    int *iterationen);
+
+/** Berechnet die k kleinsten Eigenwerte einer symmetrischen Matrix mit dem
+   LOBPCG-Verfahren (locally optimal block preconditioned conjugate gradient).
+   In jedem Schritt wird die Matrix mit allen Suchrichtungen eines Blocks auf
+   einmal multipliziert, die Orthogonalisierung benutzt die Gram-Matrizen
+   der Bloecke.
+   \param [in] A       Eine symmetrische quadratische Matrix.
+   \param [in] k       Die Anzahl der gesuchten Eigenwerte, 1 <= k <= n.
+   \param [in] tol     Die Toleranz wie bei joelix_eigen_lanczos.
+   \param [in] maxiter Die maximale Anzahl an Iterationen.
+   \param [in] T       Ein Vorkonditionierer oder NULL.
+   \param [in] daten   Wird an T weitergegeben.
+   \param [out] eigenwerte Ein Array der Laenge k, aufsteigend sortiert.
+   \param [in,out] eigenvektoren Ein Array von k Vektoren der Laenge n. Sind
+                       die Vektoren nicht alle null, werden sie als
+                       Startwerte benutzt. Danach stehen hier die Eigenvektoren.
+   \param [out] iterationen Die Anzahl der Iterationen, oder NULL.
+   \return             F_ERFOLG bei Erfolg, F_EIGEN_TERMINIERT_NICHT, falls
+                       die Toleranz nicht erreicht wurde, den Fehlercode von T,
+                       falls T fehlschlaegt, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_eigen_lobpcg (Joelix_sMatrix A, int k, double tol, int maxiter,
+                                   Joelix_Vorkonditionierer T, void *daten,
+                                   double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                   int *iterationen);
+
+/** Wie joelix_eigen_lanczos, aber fuer einen Operator. Damit koennen
+   Eigenwerte von Matrizen berechnet werden, die nie gespeichert werden,
+   z.B. von einem Stencil-Operator.
+   \param [in] A       Ein symmetrischer Operator mit gleicher Zeilen- und
+                       Spaltenanzahl.
+   Die anderen Parameter und der Rueckgabewert wie bei joelix_eigen_lanczos.
+ */
+Joelix_Fehler joelix_eigen_lanczos_op (Joelix_Operator A, int k, double tol, int maxiter,
+                                       double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                       int *iterationen);
+
+/** Wie joelix_eigen_lobpcg, aber fuer einen Operator. Die Produkte mit den
+   Bloecken laufen ueber die Mehrfach-Funktion des Operators, falls er eine hat.
+   \param [in] A       Ein symmetrischer Operator mit gleicher Zeilen- und
+                       Spaltenanzahl.
+   Die anderen Parameter und der Rueckgabewert wie bei joelix_eigen_lobpcg.
+ */
+Joelix_Fehler joelix_eigen_lobpcg_op (Joelix_Operator A, int k, double tol, int maxiter,
+                                      Joelix_Vorkonditionierer T, void *daten,
+                                      double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                      int *iterationen);
+
+#endif
@@ -40,7 +40,13 @@ typedef enum {
     F_FALSCHE_DIMENSIONEN_MATRIX_NICHT_QUADRATISCH,
     F_FALSCHE_ANZAHL_NICHT_NULL_WERTE,
     F_FILEIO_FEHLER,
-    F_CG_TERMINIERT_NICHT
+    F_CG_TERMINIERT_NICHT,
+    F_THREAD_FEHLER, /**< Threads konnten nicht erzeugt werden */
+    F_MPI_FEHLER, /**< Fehler in der MPI Kommunikation */
+    F_EIGEN_TERMINIERT_NICHT, /**< Eigenwertloeser hat Toleranz nicht erreicht */
+    F_DATEI_FORMAT, /**< Datei hat falsches Format oder falsche Pruefsumme */
+    F_FALSCHES_MUSTER, /**< Matrizen haben nicht dasselbe Muster */
+    F_NUMA_FEHLER /**< Die NUMA Knoten konnten nicht abgefragt werden */
 } Joelix_Fehler;
 
 /** Variable, welche immer den zuletzt erzeugten Fehlercode speicher. */
@@ -0,0 +1,114 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_KONTEXT_H__
+#define __JOELIX_KONTEXT_H__
+
+#include "joelix_error.h"
+
+/** \file kontext.h Hier werden die Funktionen fuer den Ausfuehrungskontext
+  festgelegt. Ein Kontext besitzt eine Gruppe von Threads, die fest an
+  einzelne CPUs gebunden sind. Vektoren und Matrizen, die mit einem Kontext
+  initialisiert werden, werden von genau den Threads zum ersten Mal
+  beschrieben, die spaeter auch die zugehoerigen Zeilen bearbeiten
+  ("first touch"). Dadurch liegen die Speicherseiten auf NUMA-Systemen
+  auf dem Knoten des Threads, der sie benutzt.
+
+  Alle Funktionen mit der Endung _kontext benutzen die gleiche Aufteilung:
+  Thread t bearbeitet die Zeilen bzw. Eintraege
+  n*t/nthreads <= i < n*(t+1)/nthreads.
+
+  Ein Kontext fuehrt immer nur eine Aufgabe zur Zeit aus und sollte nur von
+  einem Thread benutzt werden; gleichzeitige Aufrufe aus mehreren Threads
+  werden nacheinander ausgefuehrt, die Zwischenspeicher der Reduktionen
+  (z.B. joelix_vektor_dot_kontext) sind aber nicht dagegen geschuetzt.
+  Eine Funktion, die einen Kontext benutzt, darf nicht von den Threads
+  desselben Kontexts aufgerufen werden, etwa aus einem Operator oder
+  Vorkonditionierer heraus, der selbst parallel mit demselben Kontext
+  rechnet. Sie gibt dann F_THREAD_FEHLER zurueck, statt zu blockieren. */
+
+/** Der Datentyp fuer Ausfuehrungskontexte. */
+typedef struct Joelix_Kontext_t * Joelix_Kontext;
+
+/** Erstellt einen Ausfuehrungskontext mit nthreads Threads.
+   Die Threads werden gleichmaessig auf die NUMA-Knoten verteilt und an
+   jeweils eine CPU gebunden, die der aufrufende Prozess benutzen darf.
+   \param [in,out] pKontext Pointer auf den Kontext, der initialisiert
+                   werden soll.
+   \param [in] nthreads Anzahl der Threads. Bei nthreads <= 0 wird fuer jede
+                   erlaubte CPU ein Thread erzeugt.
+   \return         F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_kontext_init (Joelix_Kontext *pKontext, int nthreads);
+
+/** Gebe die Anzahl der Threads eines Kontexts aus.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return        Die Anzahl der Threads oder -1 bei Fehler.
+ */
+int joelix_kontext_threads (Joelix_Kontext K);
+
+/** Schaltet reproduzierbare Reduktionen ein oder aus. Im reproduzierbaren
+   Modus liefern joelix_vektor_dot_kontext und joelix_vektor_norm_kontext
+   fuer jede Anzahl von Threads bitweise dasselbe Ergebnis: Die Vektoren
+   werden in Bloecke fester Laenge eingeteilt, jeder Block wird in fester
+   Reihenfolge summiert und die Blocksummen in einem festen Baum addiert.
+   Das kostet etwas mehr als die normale Reduktion, deren Ergebnis von der
+   Anzahl der Threads abhaengt. Zu Beginn ist der Modus aus.
+   \param [in,out] K  Ein mit joelix_kontext_init initialisierter Kontext.
+   \param [in] ein    1 zum Einschalten, 0 zum Ausschalten.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_kontext_reproduzierbar (Joelix_Kontext K, int ein);
+
+/** Gebe die CPU aus, an die ein Thread gebunden ist.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \param [in] t      Ein Threadindex, 0 <= t < Anzahl Threads.
+   \return        Die CPU oder -1, falls der Thread nicht gebunden ist
+                  oder bei Fehler.
+ */
+int joelix_kontext_thread_cpu (Joelix_Kontext K, int t);
+
+/** Gebe den NUMA-Knoten aus, auf dem ein Thread laeuft.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \param [in] t      Ein Threadindex, 0 <= t < Anzahl Threads.
+   \return        Der Knoten oder -1 bei Fehler.
+ */
+int joelix_kontext_thread_knoten (Joelix_Kontext K, int t);
+
+/** Gebe die Anzahl der NUMA-Knoten des Systems aus.
+   \return        Die Anzahl der Knoten, mindestens 1.
+ */
+int joelix_kontext_knoten_anzahl (void);
+
+/** Beendet alle Threads eines Kontexts und gibt dessen Speicher frei.
+   Vektoren und Matrizen, die mit dem Kontext erstellt wurden, bleiben
+   gueltig.
+   \param [in,out] pKontext Pointer auf einen mit joelix_kontext_init
+                   initialisierten Kontext. Ist nach Ausfuehren der
+                   Funktion NULL.
+   \return         F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_kontext_loeschen (Joelix_Kontext *pKontext);
+
+#endif
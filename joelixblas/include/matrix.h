@@ -27,6 +27,7 @@
 
 #include "joelix_error.h"
 #include "vektor.h"
+#include "kontext.h"
 
 /** \file matrix.h Hier werden die Funktionen fuer das Matrix-Interface
  * festgelegt */
@@ -45,6 +46,23 @@ typedef struct Joelix_sparse_Matrix_t *Joelix_sMatrix;
 Joelix_Fehler joelix_smatrix_init (Joelix_sMatrix *pMatrix, int nzeilen, int nspalten,
                                    int nnichtnull);
 
+/** Initialisiert eine sparse Matrix wie joelix_smatrix_init, aber die Arrays
+  der Matrix werden von den Threads des Kontexts zum ersten Mal beschrieben.
+  Thread t beschreibt dabei den Anteil t/nthreads bis (t+1)/nthreads der
+  nicht-null Eintraege, die er in joelix_smatvec_kontext bearbeitet, und
+  den gleichen Anteil der Zeilen. Werte und Spalten einer Zeile liegen so
+  auf dem Knoten des Threads, der sie benutzt.
+  \param [in] pMatrix    Pointer auf die Matrix (vom Typ Joelix_sMatrix) die
+                         initialisiert werden soll.
+  \param [in] nzeilen    Die Anzahl an Zeilen der Matrix.
+  \param [in] nspalten   Die Anzahl an Spalten der Matrix.
+  \param [in] nnichtnull Die Anzahl an nicht-null Eintraegen der Matrix.
+  \param [in] K          Ein mit joelix_kontext_init initialisierter Kontext.
+  \return                F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_init_kontext (Joelix_sMatrix *pMatrix, int nzeilen, int nspalten,
+                                           int nnichtnull, Joelix_Kontext K);
+
 /** Befuelle eine Zeile einer sparse Matrix mit Eintraegen.
    Nachdem die Matrix mit joelix_smatrix_init initialisiert wurde, muss diese Funktion
    fuer jede Zeile mit nicht-null Eintraegen aufgerufen werden. Die Aufrufe muessen in
@@ -59,6 +77,9 @@ Joelix_Fehler joelix_smatrix_init (Joelix_sMatrix *pMatrix, int nzeilen, int nsp
    Warnung:            Es wird nicht ueberprueft, ob die Spaltenindices alle
                        innerhalb der zulaessigen Grenzen liegen (0 <= j <
                        Anzahl_Spalten).
+   Hat die Matrix ein gemeinsames Muster (siehe muster.h), werden nur die Werte
+   eingetragen. Die Zeilen koennen dann in beliebiger Reihenfolge befuellt
+   werden, die Spalten muessen aber genau die des Musters sein.
  */
 Joelix_Fehler joelix_smatrix_fuelleZeile (Joelix_sMatrix M, int zeile, int znichtnull,
                                           double * werte, int * spalten);
@@ -98,6 +119,46 @@ Joelix_Fehler joelix_smatrix_aendernneintrag (Joelix_sMatrix M, int zeile,
  */
 Joelix_Fehler joelix_smatvec (Joelix_Vektor b, Joelix_sMatrix M, Joelix_Vektor x);
 
+/** Berechnet b = Mx parallel mit den Threads eines Kontexts.
+   Thread t berechnet die Zeilen ab der ersten Zeile, vor der mindestens
+   nnE*t/nthreads Eintraege liegen, bis vor die entsprechende Zeile von
+   Thread t+1.
+   \param [in]  M    Eine vollstaendig befuellte Matrix mit m Spalten und
+                     n Zeilen.
+   \param [in]  x    Ein mit joelix_vektor_neu erstellter Vektor. (input)
+   \param [in,out]  b    Ein mit joelix_vektor_neu erstellter Vektor. (output)
+   \param [in]  K    Ein mit joelix_kontext_init initialisierter Kontext.
+   \return           F_ERFOLG bei Erfolg, F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR,
+                     wenn b nicht Laenge n oder x nicht Laenge m hat, sonst
+                     ein anderer Fehlercode.
+   Warnung: b und x muessen verschiedene Vektoren sein.
+ */
+Joelix_Fehler joelix_smatvec_kontext (Joelix_Vektor b, Joelix_sMatrix M, Joelix_Vektor x,
+                                      Joelix_Kontext K);
+
+/** Baut den Spaltenzugriff einer Matrix auf, den joelix_smatvec_delta
+   benutzt. Ohne diesen Aufruf wird er beim ersten joelix_smatvec_delta
+   aufgebaut. Da das nicht gleichzeitig aus mehreren Threads geschehen darf,
+   sollte die Funktion vorher aufgerufen werden, wenn mehrere Threads mit
+   derselben Matrix rechnen. Der Spaltenzugriff braucht etwa so viel
+   Speicher wie die Indices der Matrix und wird verworfen, sobald
+   joelix_smatrix_fuelleZeile das Muster aendert. Geaenderte Werte machen
+   ihn nicht ungueltig.
+   \param [in] M      Eine vollstaendig befuellte Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_spaltenzugriff (Joelix_sMatrix M);
+
+/** Ermittle, auf welchen NUMA Knoten die Daten einer Matrix liegen.
+   \param [in] M      Eine mit joelix_smatrix_init initialisierte Matrix.
+   \param [out] seiten Ein Array der Laenge nknoten. An Stelle k steht danach
+                   die Anzahl der Speicherseiten von werte, zeilen_akk und
+                   spalten_ind auf Knoten k.
+   \param [in] nknoten Laenge von seiten, z.B. joelix_kontext_knoten_anzahl ().
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_platzierung (Joelix_sMatrix M, int *seiten, int nknoten);
+
 /** Gebe eine sparse matrix auf der Konsole aus.
  *  \param [in] M    Eine mit joelix_smatrix_neu erstellte Matrix.
  *  \return          F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
@@ -0,0 +1,127 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_MUSTER_H__
+#define __JOELIX_MUSTER_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+#include "kontext.h"
+
+/** \file muster.h Hier werden gemeinsame Muster fuer sparse Matrizen
+  festgelegt. Mehrere Matrizen auf demselben Gitter (z.B. Massen- und
+  Steifigkeitsmatrix) haben dieselben zeilen_akk und spalten_ind. Mit einem
+  Muster werden diese nur einmal gespeichert, jede Matrix hat nur noch ihre
+  eigenen Werte. Das Muster zaehlt, wie viele Matrizen es benutzen, und wird
+  mit der letzten geloescht.
+  Fuer Matrizen mit demselben Muster gibt es Linearkombinationen, die die
+  Indices nur einmal lesen.
+  Der Referenzzaehler ist nicht gegen gleichzeitige Aenderungen geschuetzt,
+  Matrizen mit demselben Muster duerfen also nicht gleichzeitig aus
+  mehreren Threads erstellt oder geloescht werden. */
+
+/** Der Datentyp fuer ein gemeinsames Muster. */
+typedef struct Joelix_Muster_t * Joelix_Muster;
+
+/** Erstellt ein Muster aus der CSR Darstellung. Die Arrays werden kopiert.
+   \param [in,out] pMuster Pointer auf das Muster.
+   \param [in] n           Die Anzahl der Zeilen.
+   \param [in] m           Die Anzahl der Spalten.
+   \param [in] nnE         Die Anzahl der nicht-null Eintraege.
+   \param [in] zeilen_akk  Array der Laenge n+1 mit zeilen_akk[0] = 0,
+                           aufsteigend und zeilen_akk[n] = nnE.
+   \param [in] spalten_ind Array der Laenge nnE mit Spaltenindices 0 <= j < m.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_muster_init (Joelix_Muster *pMuster, int n, int m, int nnE,
+                                  const int *zeilen_akk, const int *spalten_ind);
+
+/** Gibt das Muster einer vollstaendig befuellten Matrix aus. Die Indices von M
+   werden nicht kopiert, sondern gehen in das Muster ueber, das M danach mit
+   allen anderen Matrizen teilt, die mit dem Muster erstellt werden. Hat M
+   schon ein Muster, wird dieses ausgegeben.
+   \param [in,out] pMuster Pointer auf das Muster.
+   \param [in,out] M      Eine vollstaendig befuellte Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_muster_aus_smatrix (Joelix_Muster *pMuster, Joelix_sMatrix M);
+
+/** Initialisiert eine sparse Matrix mit dem Muster P. Alle Werte sind danach
+   0 und werden mit joelix_smatrix_fuelleZeile oder
+   joelix_smatrix_aendernneintrag gesetzt.
+   \param [in,out] pMatrix Pointer auf die Matrix.
+   \param [in] P          Ein initialisiertes Muster.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_init_muster (Joelix_sMatrix *pMatrix, Joelix_Muster P);
+
+/** Gebe die Anzahl der Referenzen auf ein Muster aus, also die Anzahl der
+   Matrizen mit diesem Muster plus die Anzahl der noch nicht geloeschten
+   Muster-Handles.
+   \param [in] P      Ein initialisiertes Muster.
+   \return        Die Anzahl der Referenzen oder -1 bei Fehler.
+ */
+int joelix_muster_referenzen (Joelix_Muster P);
+
+/** Gibt die Referenz des Handles auf das Muster ab. Der Speicher wird erst
+   freigegeben, wenn auch alle Matrizen mit diesem Muster geloescht sind.
+   \param [in,out] pMuster Pointer auf ein initialisiertes Muster.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_muster_loeschen (Joelix_Muster *pMuster);
+
+/** Berechnet C = aA + bB in einem Durchlauf ueber die Werte. A, B und C
+   muessen dasselbe Muster haben, C darf A oder B sein.
+   \param [out] C         Eine Matrix mit dem Muster von A.
+   \param [in] a          Der Faktor vor A.
+   \param [in] A          Eine Matrix.
+   \param [in] b          Der Faktor vor B.
+   \param [in] B          Eine Matrix mit dem Muster von A.
+   \param [in] K          Ein Kontext oder NULL. Mit K werden die Werte auf
+                          die Threads von K verteilt.
+   \return        F_ERFOLG bei Erfolg, F_FALSCHES_MUSTER, falls die Muster
+                  verschieden sind, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_linearkombination (Joelix_sMatrix C, double a, Joelix_sMatrix A,
+                                                double b, Joelix_sMatrix B, Joelix_Kontext K);
+
+/** Berechnet y = (aA + bB) x, ohne die Summe zu speichern. Die Indices werden
+   dabei nur einmal gelesen.
+   \param [out] y         Ein Vektor der Laenge n (Zeilen von A), nicht x.
+   \param [in] a          Der Faktor vor A.
+   \param [in] A          Eine vollstaendig befuellte Matrix.
+   \param [in] b          Der Faktor vor B.
+   \param [in] B          Eine Matrix mit dem Muster von A.
+   \param [in] x          Ein Vektor der Laenge m (Spalten von A).
+   \param [in] K          Ein Kontext oder NULL. Mit K werden die Zeilen auf
+                          die Threads von K verteilt.
+   \return        F_ERFOLG bei Erfolg, F_FALSCHES_MUSTER, falls die Muster
+                  verschieden sind, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatvec_linearkombination (Joelix_Vektor y, double a, Joelix_sMatrix A,
+                                                double b, Joelix_sMatrix B, Joelix_Vektor x,
+                                                Joelix_Kontext K);
+
+#endif
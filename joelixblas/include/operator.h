@@ -0,0 +1,142 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_OPERATOR_H__
+#define __JOELIX_OPERATOR_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+
+/** \file operator.h Hier werden die Funktionen fuer lineare Operatoren
+  festgelegt. Ein Operator ist eine Matrix, von der nur bekannt sein muss,
+  wie sie mit einem Vektor multipliziert wird. Das kann eine gespeicherte
+  Joelix_sMatrix sein, ein Stencil auf einem regelmaessigen Gitter, dessen
+  Eintraege nie gespeichert werden, oder eine eigene Funktion.
+  Alle Verfahren mit der Endung _op (z.B. joelix_eigen_lanczos_op) arbeiten
+  mit beliebigen Operatoren. */
+
+/** Der Datentyp fuer Operatoren. */
+typedef struct Joelix_Operator_t * Joelix_Operator;
+
+/** Berechnet y = Ax fuer einen Operator A.
+   \param [out] y     Array der Laenge n (Zeilen von A).
+   \param [in] x      Array der Laenge m (Spalten von A).
+   \param [in] daten  Der Pointer, der joelix_operator_init uebergeben wurde.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+typedef Joelix_Fehler (*Joelix_Operator_Funktion) (double *y, const double *x, void *daten);
+
+/** Berechnet Y = AX fuer nvek Vektoren auf einmal. X und Y sind zeilenweise
+   gespeichert: Eintrag i von Vektor v steht an Stelle i*nvek+v.
+   \param [out] Y     Array der Laenge n*nvek.
+   \param [in] X      Array der Laenge m*nvek.
+   \param [in] nvek   Die Anzahl der Vektoren.
+   \param [in] daten  Der Pointer, der joelix_operator_init uebergeben wurde.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+typedef Joelix_Fehler (*Joelix_Operator_Mehrfach) (double *Y, const double *X, int nvek,
+                                                   void *daten);
+
+/** Die Stencils fuer joelix_operator_stencil. Die Punkte eines Stencils
+   sind lexikographisch nach den Verschiebungen (dz, dy, dx) sortiert, in
+   dieser Reihenfolge werden auch die Koeffizienten erwartet. */
+typedef enum {
+  JOELIX_STENCIL_5 = 0, /**< 2D, 5 Punkte: (0,-1,0), (0,0,-1), (0,0,0), (0,0,1), (0,1,0) */
+  JOELIX_STENCIL_7,     /**< 3D, 7 Punkte: Mitte und die 6 direkten Nachbarn */
+  JOELIX_STENCIL_27     /**< 3D, 27 Punkte: alle dz, dy, dx in {-1, 0, 1},
+                             Punkt p = 9(dz+1) + 3(dy+1) + (dx+1) */
+} Joelix_Stencil;
+
+/** Erstellt einen Operator aus eigenen Funktionen.
+   \param [in,out] pOperator Pointer auf den Operator.
+   \param [in] n          Die Anzahl der Zeilen.
+   \param [in] m          Die Anzahl der Spalten.
+   \param [in] anwenden   Berechnet y = Ax.
+   \param [in] mehrfach   Berechnet Y = AX fuer mehrere Vektoren oder NULL.
+                          Bei NULL wird anwenden fuer jeden Vektor aufgerufen.
+   \param [in] daten      Wird an anwenden und mehrfach weitergegeben.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_operator_init (Joelix_Operator *pOperator, int n, int m,
+                                    Joelix_Operator_Funktion anwenden,
+                                    Joelix_Operator_Mehrfach mehrfach, void *daten);
+
+/** Erstellt einen Operator fuer eine gespeicherte Matrix. Der Operator
+   benutzt den Kernel, den joelix_smatvec fuer M benutzt. M wird nicht
+   kopiert und muss laenger existieren als der Operator.
+   \param [in,out] pOperator Pointer auf den Operator.
+   \param [in] M          Eine vollstaendig befuellte Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_operator_aus_smatrix (Joelix_Operator *pOperator, Joelix_sMatrix M);
+
+/** Erstellt einen matrixfreien Operator fuer einen Stencil auf einem
+   nx x ny (x nz) Gitter. Gitterpunkt (x, y, z) ist Zeile x + nx (y + ny z).
+   Nachbarn ausserhalb des Gitters werden weggelassen (homogene Dirichlet
+   Randwerte). Fuer JOELIX_STENCIL_5 muss nz = 1 sein.
+   \param [in,out] pOperator Pointer auf den Operator.
+   \param [in] art        Der Stencil.
+   \param [in] nx, ny, nz Die Groesse des Gitters.
+   \param [in] koeff      Die Koeffizienten, sie werden kopiert. Bei
+                          konstanten Koeffizienten ein Array mit einem Wert pro
+                          Punkt des Stencils. Bei variablen Koeffizienten ein
+                          Array der Laenge Punkte * N mit N = nx ny nz, der
+                          Koeffizient von Punkt p in Zeile i steht an Stelle
+                          p*N + i.
+   \param [in] variabel   0 fuer konstante, 1 fuer variable Koeffizienten.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_operator_stencil (Joelix_Operator *pOperator, Joelix_Stencil art,
+                                       int nx, int ny, int nz, const double *koeff,
+                                       int variabel);
+
+/** Gebe die Anzahl der Zeilen eines Operators aus.
+   \param [in] A      Ein initialisierter Operator.
+   \return        Die Anzahl der Zeilen oder -1 bei Fehler.
+ */
+int joelix_operator_zeilen (Joelix_Operator A);
+
+/** Gebe die Anzahl der Spalten eines Operators aus.
+   \param [in] A      Ein initialisierter Operator.
+   \return        Die Anzahl der Spalten oder -1 bei Fehler.
+ */
+int joelix_operator_spalten (Joelix_Operator A);
+
+/** Berechnet b = Ax, wie joelix_smatvec fuer Operatoren.
+   \param [out] b     Ein Vektor der Laenge n (Zeilen von A).
+   \param [in] A      Ein initialisierter Operator.
+   \param [in] x      Ein Vektor der Laenge m (Spalten von A).
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_opvec (Joelix_Vektor b, Joelix_Operator A, Joelix_Vektor x);
+
+/** Gibt den Speicher eines Operators wieder frei. Eine Matrix, aus der der
+   Operator erstellt wurde, bleibt erhalten.
+   \param [in,out] pOperator Pointer auf einen initialisierten Operator.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_operator_loeschen (Joelix_Operator *pOperator);
+
+#endif
@@ -0,0 +1,94 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_OPTIMIEREN_H__
+#define __JOELIX_OPTIMIEREN_H__
+
+#include "joelix_error.h"
+#include "kontext.h"
+#include "matrix.h"
+
+/** \file optimieren.h Hier werden die Funktionen festgelegt, mit denen fuer
+  eine Matrix der schnellste Kernel fuer das Matrix-Vektor Produkt
+  ausgewaehlt wird. Nach joelix_smatrix_optimieren benutzt jeder Aufruf von
+  joelix_smatvec den ausgewaehlten Kernel. */
+
+/** Die verfuegbaren Kernel fuer das Matrix-Vektor Produkt. */
+typedef enum {
+  JOELIX_SPMV_CSR = 0,  /**< Die einfache Schleife ueber die Zeilen. */
+  JOELIX_SPMV_CSR_UNROLL, /**< Wie CSR, aber mit vier Teilsummen pro Zeile. */
+  JOELIX_SPMV_CSR_GATHER, /**< Wie CSR, die Eintraege von x werden in Bloecken
+                               von 8 gesammelt, damit der Compiler das Produkt
+                               vektorisieren kann. */
+  JOELIX_SPMV_ELL,        /**< Eine zusaetzliche Kopie der Matrix im ELLPACK
+                               Format. Nur fuer Matrizen mit etwa gleich
+                               langen Zeilen. */
+  JOELIX_SPMV_ANZAHL      /**< Die Anzahl der Kernel. */
+} Joelix_SpMV_Kernel;
+
+/** Waehle den schnellsten Kernel und die beste Threadanzahl fuer das
+   Matrix-Vektor Produkt mit M aus.
+   Aus zeilen_akk werden Merkmale der Matrix bestimmt (Groesse, Anzahl der
+   Eintraege, Statistik der Zeilenlaengen). Gibt es fuer diese Merkmale schon
+   einen Eintrag in der Datei dateiname, so wird dieser benutzt. Sonst werden
+   alle Kernel mit 1, 2, 4, ... Threads von K gemessen, der schnellste
+   ausgewaehlt und in dateiname eingetragen.
+   Die Matrix muss vollstaendig befuellt sein. Wird sie danach mit
+   joelix_smatrix_fuelleZeile veraendert, wird wieder der einfache Kernel
+   benutzt.
+   \param [in,out] M   Eine vollstaendig befuellte Matrix.
+   \param [in] K       Ein Kontext oder NULL. Ist K NULL, wird nur mit einem
+                       Thread gerechnet. Sonst muss K laenger existieren als
+                       die Optimierung von M benutzt wird.
+   \param [in] dateiname Die Datei mit den bisherigen Entscheidungen oder NULL.
+                       Existiert die Datei nicht, wird sie angelegt.
+   \return             F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_optimieren (Joelix_sMatrix M, Joelix_Kontext K,
+                                         const char *dateiname);
+
+/** Setze den Kernel fuer das Matrix-Vektor Produkt mit M direkt.
+   \param [in,out] M   Eine vollstaendig befuellte Matrix.
+   \param [in] kernel  Der Kernel.
+   \param [in] K       Ein Kontext oder NULL.
+   \param [in] threads Die Anzahl der Threads von K, die rechnen sollen.
+                       Muss 1 sein, wenn K NULL ist.
+   \return             F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatrix_setze_kernel (Joelix_sMatrix M, Joelix_SpMV_Kernel kernel,
+                                           Joelix_Kontext K, int threads);
+
+/** Gebe den Kernel aus, den joelix_smatvec fuer M benutzt.
+   \param [in] M      Eine mit joelix_smatrix_init initialisierte Matrix.
+   \return        Der Kernel oder -1 bei Fehler.
+ */
+int joelix_smatrix_kernel (Joelix_sMatrix M);
+
+/** Gebe die Anzahl der Threads aus, die joelix_smatvec fuer M benutzt.
+   \param [in] M      Eine mit joelix_smatrix_init initialisierte Matrix.
+   \return        Die Anzahl der Threads oder -1 bei Fehler.
+ */
+int joelix_smatrix_kernel_threads (Joelix_sMatrix M);
+
+#endif
@@ -0,0 +1,121 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_SVEKTOR_H__
+#define __JOELIX_SVEKTOR_H__
+
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+
+/** \file svektor.h Hier werden die Funktionen fuer sparse Vektoren
+  festgelegt. Ein sparse Vektor speichert nur einige Eintraege als Paare
+  (Index, Wert), z.B. die Aenderung dx eines Vektors x, die nur wenige
+  Eintraege betrifft. Mit joelix_smatvec_delta kann dann b = Mx angepasst
+  werden, ohne das ganze Produkt neu zu berechnen. */
+
+/** Der Datentyp fuer sparse Vektoren. */
+typedef struct Joelix_sparse_Vektor_t * Joelix_sVektor;
+
+/** Initialisiert einen sparse Vektor ohne Eintraege.
+   \param [in,out] pVektor Pointer auf den Vektor.
+   \param [in] n          Die Laenge des Vektors.
+   \param [in] kapazitaet Fuer so viele Eintraege wird Platz reserviert. Werden
+                          mehr eingetragen, waechst der Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_init (Joelix_sVektor *pVektor, int n, int kapazitaet);
+
+/** Entfernt alle Eintraege. Der reservierte Platz bleibt erhalten.
+   \param [in,out] x      Ein initialisierter sparse Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_null (Joelix_sVektor x);
+
+/** Fuegt einen Eintrag hinzu. Wird ein Index mehrmals eingetragen, gilt die
+   Summe der Werte.
+   \param [in,out] x      Ein initialisierter sparse Vektor.
+   \param [in] i          Der Index, 0 <= i < n.
+   \param [in] wert       Der Wert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_hinzufuegen (Joelix_sVektor x, int i, double wert);
+
+/** Traegt die Differenz xneu - xalt an allen Stellen ein, an denen sich die
+   beiden Vektoren unterscheiden. Vorherige Eintraege werden entfernt.
+   \param [in,out] dx     Ein initialisierter sparse Vektor der Laenge n.
+   \param [in] xneu       Ein Vektor der Laenge n.
+   \param [in] xalt       Ein Vektor der Laenge n.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_differenz (Joelix_sVektor dx, Joelix_Vektor xneu,
+                                        Joelix_Vektor xalt);
+
+/** Gebe die Laenge eines sparse Vektors aus.
+   \param [in] x      Ein initialisierter sparse Vektor.
+   \return        Die Laenge oder -1 bei Fehler.
+ */
+int joelix_svektor_laenge (Joelix_sVektor x);
+
+/** Gebe die Anzahl der gespeicherten Eintraege aus.
+   \param [in] x      Ein initialisierter sparse Vektor.
+   \return        Die Anzahl oder -1 bei Fehler.
+ */
+int joelix_svektor_anzahl (Joelix_sVektor x);
+
+/** Lese den k-ten gespeicherten Eintrag.
+   \param [in] x      Ein initialisierter sparse Vektor.
+   \param [in] k      0 <= k < joelix_svektor_anzahl (x).
+   \param [out] i     Pointer auf einen int fuer den Index.
+   \param [out] wert  Pointer auf einen double fuer den Wert.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_eintrag (Joelix_sVektor x, int k, int *i, double *wert);
+
+/** Berechnet y = y + alpha x fuer einen sparse Vektor x.
+   \param [in,out] y      Ein Vektor der Laenge n.
+   \param [in] x          Ein sparse Vektor der Laenge n.
+   \param [in] alpha      Der Faktor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_saxpy (Joelix_Vektor y, Joelix_sVektor x, double alpha);
+
+/** Berechnet b = b + M dx, also die Aenderung von b = Mx, wenn x um dx
+   geaendert wird. Es werden nur die Spalten von M gelesen, die zu den
+   Eintraegen von dx gehoeren. Beim ersten Aufruf wird dafuer der
+   Spaltenzugriff von M aufgebaut (siehe joelix_smatrix_spaltenzugriff).
+   \param [in,out] b      Ein Vektor der Laenge n (Zeilen von M).
+   \param [in] M          Eine vollstaendig befuellte Matrix.
+   \param [in] dx         Ein sparse Vektor der Laenge m (Spalten von M).
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_smatvec_delta (Joelix_Vektor b, Joelix_sMatrix M, Joelix_sVektor dx);
+
+/** Gibt den Speicher eines sparse Vektors wieder frei.
+   \param [in,out] pVektor Pointer auf einen initialisierten sparse Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_svektor_loeschen (Joelix_sVektor *pVektor);
+
+#endif
@@ -26,6 +26,7 @@
 #define __JOELIX_VEKTOR_H__
 
 #include "joelix_error.h"
+#include "kontext.h"
 
 /** \file vektor.h Hier werden die Funktionen fuer das Vektor-Interface
   festgelegt. */ 
@@ -98,20 +99,30 @@ Joelix_Fehler joelix_vektor_ax (Joelix_Vektor x, double alpha);
 Joelix_Fehler joelix_vektor_axpy (Joelix_Vektor y, Joelix_Vektor x, double alpha);
 
 /** Berechnet das Skalarprodukt zweier Vektoren.
-   \param [out] produkt Ein Pointer auf eine initialisierte Double Variable.
+   \param [out] produkt Ein Pointer auf eine Double Variable, die mit dem
+                   Ergebnis ueberschrieben wird.
    \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
    \param [in] y      Ein mit joelix_vektor_init initialisierter Vektor mit gleicher Laenge wie x.
    \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
  */
 Joelix_Fehler joelix_vektor_dot (double * produkt, Joelix_Vektor x, Joelix_Vektor y);
 
+/** Berechnet die euklidische Norm eines Vektors.
+   \param [out] norm  Ein Pointer auf eine Double Variable fuer das Ergebnis.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_norm (double * norm, Joelix_Vektor x);
+
 /** Gebe einen Vektor auf der Konsole aus.
    \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
    \return       F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
  */
 Joelix_Fehler joelix_vektor_print (Joelix_Vektor x);
 
-/** Gebe einen Vektor in eine Datei aus.
+/** Gebe einen Vektor in eine Datei aus. Jede Zeile enthaelt i/(n-1) und den
+   i-ten Eintrag, jeweils mit so wenigen Stellen, dass beim Einlesen wieder
+   genau derselbe Wert entsteht (siehe auch datei.h).
    \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
    \param [in] filename Der Name der Outputdatei. Die Datei wird ueberschrieben,
                    falls sie existiert.
@@ -119,6 +130,85 @@ Joelix_Fehler joelix_vektor_print (Joelix_Vektor x);
  */
 Joelix_Fehler joelix_vektor_print_tofile (Joelix_Vektor x, char * filename);
 
+/** Initialisiert einen Vektor der Laenge n und fuellt diesen mit Nullen auf.
+   Die Nullen werden von den Threads des Kontexts geschrieben, so dass jeder
+   Eintrag auf dem NUMA Knoten des Threads liegt, der ihn in den
+   _kontext Funktionen bearbeitet.
+   \param [in,out] pVektor Pointer auf den Vektor (vom Typ Joelix_Vektor) der
+                    initialisiert werden soll.
+   \param [in] n       Laenge des zu erstellenden Vektors.
+   \param [in] K       Ein mit joelix_kontext_init initialisierter Kontext.
+   \return         F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_init_kontext (Joelix_Vektor *pVektor, int n, Joelix_Kontext K);
+
+/** Setze parallel alle Eintraege eines Vektor auf den Wert 0.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_null_kontext (Joelix_Vektor x, Joelix_Kontext K);
+
+/** Berechnet parallel y = x.
+  \param [in] x          Ein mit joelix_vektor_init initialisierter Vektor.
+  \param [in,out] y      Ein mit joelix_vektor_init initialisierter Vektor mit gleicher Laenge wie x.
+  \param [in] K          Ein mit joelix_kontext_init initialisierter Kontext.
+  \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+*/
+Joelix_Fehler joelix_vektor_copy_kontext (Joelix_Vektor y, Joelix_Vektor x, Joelix_Kontext K);
+
+/** Berechne parallel x = alpha * x fuer einen Vektor x und einen Skalar alpha.
+   \param [in] alpha  Skalar.
+   \param [in,out]  x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_ax_kontext (Joelix_Vektor x, double alpha, Joelix_Kontext K);
+
+/** Berechnet parallel y = alpha * x + y fuer Vektoren x und y und einen
+   reellen Skalar alpha.
+   \param [in] alpha  Skalar.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in,out] y      Ein mit joelix_vektor_init initialisierter Vektor mit gleicher Laenge wie x.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_axpy_kontext (Joelix_Vektor y, Joelix_Vektor x, double alpha,
+                                          Joelix_Kontext K);
+
+/** Berechnet parallel das Skalarprodukt zweier Vektoren.
+   Die Teilsummen der Threads werden in fester Reihenfolge addiert, das
+   Ergebnis haengt also nur von der Anzahl der Threads ab. Ist der Kontext
+   mit joelix_kontext_reproduzierbar umgeschaltet, haengt es auch davon
+   nicht mehr ab.
+   \param [out] produkt Ein Pointer auf eine Double Variable, die mit dem
+                   Ergebnis ueberschrieben wird.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] y      Ein mit joelix_vektor_init initialisierter Vektor mit gleicher Laenge wie x.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_dot_kontext (double * produkt, Joelix_Vektor x, Joelix_Vektor y,
+                                         Joelix_Kontext K);
+
+/** Berechnet parallel die euklidische Norm eines Vektors, mit derselben
+   Reduktion wie joelix_vektor_dot_kontext.
+   \param [out] norm  Ein Pointer auf eine Double Variable fuer das Ergebnis.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [in] K      Ein mit joelix_kontext_init initialisierter Kontext.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_norm_kontext (double * norm, Joelix_Vektor x, Joelix_Kontext K);
+
+/** Ermittle, auf welchen NUMA Knoten die Eintraege eines Vektors liegen.
+   \param [in] x      Ein mit joelix_vektor_init initialisierter Vektor.
+   \param [out] seiten Ein Array der Laenge nknoten. An Stelle k steht danach
+                   die Anzahl der Speicherseiten von x auf Knoten k.
+   \param [in] nknoten Laenge von seiten, z.B. joelix_kontext_knoten_anzahl ().
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vektor_platzierung (Joelix_Vektor x, int *seiten, int nknoten);
+
 /** Gibt den Speicher, der von einem Vektor benutzt wird, wieder frei.
    \param [in,out] pVektor  Pointer auf einen von joelix_vektor_init initialiserter Vektor.
                      Ist nach Ausführen der Funktion NULL.
@@ -0,0 +1,182 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_VERTEILT_H__
+#define __JOELIX_VERTEILT_H__
+
+#include <mpi.h>
+#include "joelix_error.h"
+#include "vektor.h"
+#include "matrix.h"
+
+/** \file verteilt.h Hier werden die Funktionen fuer verteilte Vektoren und
+  Matrizen festgelegt. Jeder Prozess (Rang) besitzt einen zusammenhaengenden
+  Block von Zeilen. Die Matrix muss quadratisch sein, die Vektoren sind wie
+  die Zeilen der Matrix verteilt.
+
+  Funktionen, die von allen Raengen aufgerufen werden muessen, kommunizieren
+  kollektiv. joelix_vvektor_init, joelix_vsmatrix_init,
+  joelix_vsmatrix_aufbauen und joelix_vsmatvec einigen sich vorher auf einen
+  Fehlercode, so dass alle Raenge denselben Fehler zurueckgeben. Ist aber
+  bei den anderen Funktionen ein Argument auf einem Rang falsch, oder ist
+  ein Vektor bzw. die Matrix auf einem Rang NULL, steigt nur dieser Rang
+  aus und die anderen blockieren den Kommunikator fuer immer.
+
+  Diese Funktionen sind nur vorhanden, wenn die Bibliothek mit
+  'make MPI=1' uebersetzt wurde. */
+
+/** Der Datentyp fuer verteilte Vektoren. */
+typedef struct Joelix_vVektor_t * Joelix_vVektor;
+
+/** Der Datentyp fuer verteilte sparse Matrizen. */
+typedef struct Joelix_vsMatrix_t * Joelix_vsMatrix;
+
+/** Initialisiert einen verteilten Vektor und fuellt diesen mit Nullen auf.
+   Muss von allen Raengen von comm aufgerufen werden.
+   \param [in,out] pVektor Pointer auf den Vektor der initialisiert werden soll.
+   \param [in] comm    Der MPI Kommunikator.
+   \param [in] n       Die globale Laenge des Vektors.
+   \param [in] nlokal  Die Anzahl der Eintraege auf diesem Rang. Ist nlokal < 0,
+                       so werden die Eintraege gleichmaessig aufgeteilt.
+   \return         F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode, der auf
+                   allen Raengen gleich ist.
+ */
+Joelix_Fehler joelix_vvektor_init (Joelix_vVektor *pVektor, MPI_Comm comm, int n, int nlokal);
+
+/** Gebe den lokalen Teil eines verteilten Vektors aus. Auf diesen koennen alle
+   Funktionen aus vektor.h angewendet werden. Lokaler Index i entspricht dem
+   globalen Index joelix_vvektor_anfang (x) + i.
+   \param [in] x      Ein mit joelix_vvektor_init initialisierter Vektor.
+   \return        Der lokale Vektor oder NULL bei Fehler.
+ */
+Joelix_Vektor joelix_vvektor_lokal (Joelix_vVektor x);
+
+/** Gebe den globalen Index des ersten lokalen Eintrags aus.
+   \param [in] x      Ein mit joelix_vvektor_init initialisierter Vektor.
+   \return        Der globale Index oder -1 bei Fehler.
+ */
+int joelix_vvektor_anfang (Joelix_vVektor x);
+
+/** Berechnet das Skalarprodukt zweier verteilter Vektoren. Es wird genau
+   ein MPI_Allreduce benutzt. Muss von allen Raengen aufgerufen werden.
+   \param [out] produkt Ein Pointer auf eine Double Variable. Ist auf allen
+                   Raengen gleich.
+   \param [in] x      Ein mit joelix_vvektor_init initialisierter Vektor.
+   \param [in] y      Ein wie x verteilter Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vvektor_dot (double *produkt, Joelix_vVektor x, Joelix_vVektor y);
+
+/** Berechnet die euklidische Norm eines verteilten Vektors. Es wird genau
+   ein MPI_Allreduce benutzt. Muss von allen Raengen aufgerufen werden.
+   \param [out] norm  Ein Pointer auf eine Double Variable.
+   \param [in] x      Ein mit joelix_vvektor_init initialisierter Vektor.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vvektor_norm (double *norm, Joelix_vVektor x);
+
+/** Gibt den Speicher, der von einem verteilten Vektor benutzt wird, wieder frei.
+   \param [in,out] pVektor  Pointer auf einen mit joelix_vvektor_init
+                     initialisierten Vektor. Ist nach Ausfuehren der Funktion NULL.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vvektor_loeschen (Joelix_vVektor *pVektor);
+
+/** Initialisiert eine verteilte quadratische sparse Matrix.
+   Muss von allen Raengen von comm aufgerufen werden.
+  \param [in] pMatrix    Pointer auf die Matrix die initialisiert werden soll.
+  \param [in] comm       Der MPI Kommunikator.
+  \param [in] n          Die globale Anzahl an Zeilen und Spalten.
+  \param [in] nlokal     Die Anzahl der Zeilen auf diesem Rang. Ist nlokal < 0,
+                         so werden die Zeilen gleichmaessig aufgeteilt.
+  \param [in] nnichtnull Die Anzahl an nicht-null Eintraegen in den lokalen Zeilen.
+  \return                F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode,
+                         der auf allen Raengen gleich ist.
+ */
+Joelix_Fehler joelix_vsmatrix_init (Joelix_vsMatrix *pMatrix, MPI_Comm comm, int n, int nlokal,
+                                    int nnichtnull);
+
+/** Gebe den globalen Index der ersten lokalen Zeile aus.
+   \param [in] M      Eine mit joelix_vsmatrix_init initialisierte Matrix.
+   \return        Der globale Index oder -1 bei Fehler.
+ */
+int joelix_vsmatrix_anfang (Joelix_vsMatrix M);
+
+/** Gebe die Anzahl der lokalen Zeilen aus.
+   \param [in] M      Eine mit joelix_vsmatrix_init initialisierte Matrix.
+   \return        Die Anzahl der lokalen Zeilen oder -1 bei Fehler.
+ */
+int joelix_vsmatrix_lokale_zeilen (Joelix_vsMatrix M);
+
+/** Befuelle eine lokale Zeile einer verteilten Matrix. Wie bei
+   joelix_smatrix_fuelleZeile muessen die Zeilen in aufsteigender Reihenfolge
+   befuellt werden.
+   \param [in] M          Eine mit joelix_vsmatrix_init initialisierte Matrix.
+   \param [in] zeile      Der globale Index der Zeile. Die Zeile muss auf
+                          diesem Rang liegen.
+   \param [in] znichtnull Die Anzahl der nicht-null Eintraege in dieser Zeile.
+   \param [in] werte      Ein Array der Laenge znichtnull mit den Werten.
+   \param [in] spalten    Ein Array der Laenge znichtnull mit den globalen
+                          Spaltenindices.
+   \return             F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vsmatrix_fuelleZeile (Joelix_vsMatrix M, int zeile, int znichtnull,
+                                           double *werte, int *spalten);
+
+/** Schliesst das Befuellen ab und bereitet das Matrix-Vektor Produkt vor.
+   Es wird bestimmt, welche Eintraege von x von anderen Raengen benoetigt
+   werden (Geisteintraege), und die lokalen Zeilen werden in einen lokalen
+   Teil und einen Teil mit Geistspalten aufgespalten. Danach kann die Matrix
+   nicht mehr befuellt werden. Muss von allen Raengen aufgerufen werden.
+   \param [in] M      Eine vollstaendig befuellte Matrix.
+   \return        F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode. Schlaegt
+                  der Aufbau auf einem Rang fehl, geben alle Raenge denselben
+                  Fehlercode zurueck und die Matrix bleibt unveraendert.
+ */
+Joelix_Fehler joelix_vsmatrix_aufbauen (Joelix_vsMatrix M);
+
+/** Berechnet b = Mx fuer verteilte Matrix und Vektoren. Der Austausch der
+   Geisteintraege von x laeuft nicht-blockierend, waehrend der lokale Teil
+   des Produkts berechnet wird. Muss von allen Raengen aufgerufen werden.
+   Vor dem Austausch einigen sich die Raenge mit einem MPI_Allreduce auf
+   den Fehlercode der Argumentpruefung.
+   \param [in]  M    Eine mit joelix_vsmatrix_aufbauen vorbereitete Matrix.
+   \param [in]  x    Ein wie die Zeilen von M verteilter Vektor. (input)
+   \param [in,out]  b    Ein wie die Zeilen von M verteilter Vektor. (output)
+   \return           F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode. Ein
+                     Fehler in der Argumentpruefung wird auf allen Raengen
+                     zurueckgegeben, ist b, M oder x NULL, blockieren die
+                     anderen Raenge.
+   Warnung: b und x muessen verschiedene Vektoren sein.
+ */
+Joelix_Fehler joelix_vsmatvec (Joelix_vVektor b, Joelix_vsMatrix M, Joelix_vVektor x);
+
+/** Gibt den Speicher, der von einer verteilten Matrix benutzt wird, wieder frei.
+ * \param [in,out] pM       Pointer auf eine mit joelix_vsmatrix_init erzeugte
+ *                          Matrix. Ist nach Ausfuehren der Funktion NULL.
+ *  \return          F_ERFOLG bei Erfolg, sonst ein anderer Fehlercode.
+ */
+Joelix_Fehler joelix_vsmatrix_loeschen (Joelix_vsMatrix *pM);
+
+#endif
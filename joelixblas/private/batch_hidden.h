@@ -0,0 +1,74 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_BATCH_HIDDEN_H__
+#define __JOELIX_BATCH_HIDDEN_H__
+
+/* Anzahl der Systeme mit gemeinsamem Muster, die in einem Block verschraenkt
+   gespeichert werden. Die innerste Schleife laeuft ueber die Systeme eines
+   Blocks und kann so vektorisiert werden (8 double = eine AVX-512 Operation
+   oder zwei AVX Operationen). */
+#define JOELIX_BATCH_BREITE 8
+
+struct Joelix_Batch_t
+{
+  int nsys;      /* Anzahl der Systeme */
+  int gemeinsam; /* 1, wenn alle Systeme dasselbe Muster haben */
+  int nmax;      /* Groesste Zeilenanzahl eines Systems */
+
+  /* Bei gemeinsamem Muster: n, nnE, zeilen_akk und spalten_ind wie in
+     Joelix_sparse_Matrix_t, fuer alle Systeme gleich. Die Systeme sind in
+     nblock = (nsys + JOELIX_BATCH_BREITE - 1) / JOELIX_BATCH_BREITE Bloecke
+     eingeteilt, Eintrag k von System s steht an Stelle
+     ((s / BREITE) * nnE + k) * BREITE + s % BREITE von werte. Die
+     Systeme am Ende des letzten Blocks sind 0.
+
+     Sonst hat System s sys_n[s] Zeilen. Die Muster aller Systeme stehen
+     hintereinander: zeilen_akk von System s beginnt an Stelle
+     sys_zeilen[s] + s und zaehlt ab 0, spalten_ind und werte von System s
+     beginnen an Stelle sys_eintraege[s]. */
+  int n, nnE;
+  int nblock;
+  int * zeilen_akk;
+  int * spalten_ind;
+  int * sys_n;          /* Hat Laenge nsys */
+  long * sys_zeilen;    /* Hat Laenge nsys+1 */
+  long * sys_eintraege; /* Hat Laenge nsys+1 */
+  double * werte;
+};
+
+struct Joelix_Batch_Vektor_t
+{
+  int nsys;
+  int gemeinsam;
+  int n;           /* Bei gemeinsamem Muster die Laenge aller Vektoren */
+  long * anfang;   /* Sonst hat Laenge nsys+1. System s beginnt an Stelle
+                      anfang[s], eine Kopie von sys_zeilen der Batch. */
+  long laenge;     /* Laenge von werte */
+  double * werte;  /* Bei gemeinsamem Muster steht Eintrag i von System s an
+                      Stelle ((s / BREITE) * n + i) * BREITE + s % BREITE,
+                      sonst an Stelle anfang[s] + i. */
+};
+
+#endif
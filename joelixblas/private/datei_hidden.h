@@ -0,0 +1,65 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_DATEI_HIDDEN_H__
+#define __JOELIX_DATEI_HIDDEN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define JOELIX_DATEI_VERSION 1
+#define JOELIX_DATEI_REIHENFOLGE 0x01020304u
+
+/* Der Kopf der Binaerdateien, 64 Byte. Danach folgen die Daten, die alle
+   aus 8 Byte Worten bestehen. */
+struct joelix_datei_kopf
+{
+  char kennung[8];
+  uint32_t version;
+  uint32_t reihenfolge;   /* JOELIX_DATEI_REIHENFOLGE beim Schreiben */
+  uint64_t laenge;        /* Vektor: Anzahl der Eintraege,
+                             Checkpoint: Anzahl der Vektoren,
+                             Matrix: Anzahl der Zeilen */
+  uint64_t anzahl;        /* Checkpoint: Anzahl der Skalare,
+                             Matrix: Anzahl der Spalten */
+  int64_t iteration;      /* Checkpoint: Iterationszahl */
+  uint64_t pruefsumme;    /* ueber alle Daten nach dem Kopf, bei einer
+                             Matrix ueber die Blocktabelle */
+  uint64_t reserviert[2]; /* Matrix: Anzahl der nicht-null Eintraege und
+                             Anzahl der Bloecke */
+};
+
+#define JOELIX_PRUEFSUMME_START 14695981039346656037ULL
+
+/* Berechnet die Pruefsumme ueber nworte 8 Byte Worte, beginnend mit h
+   (JOELIX_PRUEFSUMME_START oder dem Ergebnis eines vorherigen Aufrufs). */
+uint64_t joelix_pruefsumme (uint64_t h, const void *daten, size_t nworte);
+
+/* Setzt einen Kopf mit Kennung, Version und Bytereihenfolge, der Rest ist 0. */
+void joelix_kopf_init (struct joelix_datei_kopf *kopf, const char *kennung);
+
+/* Prueft Kennung, Version und Bytereihenfolge eines Kopfs. */
+int joelix_kopf_pruefen (const struct joelix_datei_kopf *kopf, const char *kennung);
+
+#endif
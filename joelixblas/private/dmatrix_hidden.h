@@ -0,0 +1,77 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_DMATRIX_HIDDEN_H__
+#define __JOELIX_DMATRIX_HIDDEN_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include "joelix_error.h"
+#include "dmatrix.h"
+
+/* Ein Eintrag der Blocktabelle am Ende der Datei, 5 Worte */
+struct joelix_dmatrix_block
+{
+  uint64_t erste_zeile; /* Die erste Zeile des Blocks */
+  uint64_t zeilen;      /* Die Anzahl der Zeilen */
+  uint64_t nnE;         /* Die Anzahl der nicht-null Eintraege */
+  uint64_t stelle;      /* Die Stelle des Blocks in der Datei in Byte */
+  uint64_t pruefsumme;  /* Ueber die Worte des Blocks */
+};
+
+struct Joelix_dMatrix_Schreiber_t
+{
+  FILE * datei;
+  int n, m;
+  int zeilen_pro_block;
+  long nnE;              /* Alle bisher geschriebenen Eintraege */
+  int naechste_zeile;    /* Die Zeilen davor sind uebergeben */
+  /* Der aktuelle Block, beginnend bei Zeile block_anfang */
+  int block_anfang;
+  int block_nnE;
+  int block_kapazitaet;  /* Platz in werte und spalten */
+  int * zeilen_akk;      /* Hat Laenge zeilen_pro_block+1 */
+  int * spalten;
+  double * werte;
+  /* Die Tabelle der fertigen Bloecke */
+  int nblock, tabelle_kapazitaet;
+  struct joelix_dmatrix_block * tabelle;
+  uint64_t stelle;       /* Hier beginnt der naechste Block */
+  Joelix_Fehler fehler;  /* Der erste Fehler beim Schreiben */
+};
+
+struct Joelix_dMatrix_t
+{
+  int datei;             /* Der file descriptor */
+  int n, m;
+  long nnE;
+  int nblock;
+  int pruefen;           /* 1, wenn die Pruefsummen geprueft werden */
+  struct joelix_dmatrix_block * tabelle;
+  size_t max_bytes;      /* Der groesste Block in Byte */
+  double * puffer[2];    /* Die beiden Puffer, je max_bytes gross */
+  Joelix_dMatrix_Statistik statistik;
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_KONTEXT_HIDDEN_H__
+#define __JOELIX_KONTEXT_HIDDEN_H__
+
+#include <stddef.h>
+#include <pthread.h>
+#include "joelix_error.h"
+
+/* Eine Aufgabe, die von jedem Thread des Kontexts einmal ausgefuehrt wird.
+   tid ist der Index des Threads, nthreads die Anzahl aller Threads. */
+typedef void (*Joelix_Kontext_Aufgabe) (void *daten, int tid, int nthreads);
+
+/* Die Daten, die jeder Arbeiter-Thread beim Start bekommt */
+struct Joelix_Kontext_Arbeiter_t
+{
+  struct Joelix_Kontext_t *K;
+  int tid;
+};
+
+/* Abstand der Teilsummen in Joelix_Kontext_t::teilsummen. Jeder Thread
+   bekommt eine eigene Cacheline, damit die Threads sich beim Schreiben der
+   Teilsummen nicht gegenseitig behindern. */
+#define JOELIX_KONTEXT_TEILSUMMEN_ABSTAND 8
+
+/* Laenge der Bloecke bei reproduzierbaren Reduktionen. Jeder Block wird
+   immer gleich summiert, egal welcher Thread ihn bearbeitet. */
+#define JOELIX_KONTEXT_BLOCK 2048
+
+struct Joelix_Kontext_t
+{
+  int nthreads;
+  pthread_t * threads;
+  struct Joelix_Kontext_Arbeiter_t * arbeiter;
+  int * cpus;   /* Hat Laenge nthreads. Die CPU an die Thread t gebunden ist,
+                   oder -1 falls nicht gebunden wurde. */
+  int * knoten; /* Hat Laenge nthreads. Der NUMA Knoten von Thread t. */
+  double * teilsummen; /* Hat Laenge nthreads * JOELIX_KONTEXT_TEILSUMMEN_ABSTAND.
+                          Zwischenspeicher fuer Reduktionen. */
+  int reproduzierbar;  /* Ist 1, wenn Reduktionen nicht von nthreads abhaengen */
+  double * bloecke;    /* Die Blocksummen reproduzierbarer Reduktionen */
+  int bloecke_kapazitaet;
+
+  /* Synchronisation zwischen aufrufendem Thread und den Arbeitern */
+  pthread_mutex_t mutex;
+  pthread_cond_t start;  /* Signalisiert eine neue Aufgabe */
+  pthread_cond_t fertig; /* Signalisiert, dass alle Arbeiter fertig sind */
+  unsigned long generation; /* Zaehlt die bisher gestellten Aufgaben */
+  int offen;                /* Anzahl der Arbeiter, die noch rechnen */
+  int beenden;              /* Ist 1, wenn die Arbeiter sich beenden sollen */
+  int belegt;               /* Ist 1, solange eine Aufgabe ausgefuehrt wird */
+  Joelix_Kontext_Aufgabe aufgabe;
+  void * daten;
+};
+
+/* Fuehre aufgabe auf allen Threads des Kontexts aus und warte, bis alle
+   fertig sind. Ruft ein anderer Thread gleichzeitig auf, wird gewartet, bis
+   die laufende Aufgabe fertig ist. Aus einer Aufgabe desselben Kontexts
+   heraus wuerde das nie passieren, dann wird F_THREAD_FEHLER
+   zurueckgegeben. */
+Joelix_Fehler joelix_kontext_ausfuehren (struct Joelix_Kontext_t *K,
+                                         Joelix_Kontext_Aufgabe aufgabe, void *daten);
+
+/* Berechne den Bereich anfang <= i < ende, den Thread tid von nthreads
+   Threads bei n Eintraegen bearbeitet. */
+void joelix_kontext_bereich (int n, int tid, int nthreads, int *anfang, int *ende);
+
+/* Zaehle, wie viele Speicherseiten von [adresse, adresse + bytes) auf
+   welchem NUMA Knoten liegen. seiten hat Laenge nknoten und wird
+   aufaddiert. Seiten, die noch nie beschrieben wurden, werden nicht
+   gezaehlt. */
+Joelix_Fehler joelix_kontext_seiten_platzierung (const void *adresse, size_t bytes,
+                                                 int *seiten, int nknoten);
+
+#endif
@@ -26,6 +26,7 @@
 #define __JOELIX_MATRIX_HIDDEN_H__
 
 #include "joelix_error.h"
+#include "kontext_hidden.h"
 
 struct Joelix_sparse_Matrix_t
 {
@@ -36,10 +37,64 @@ struct Joelix_sparse_Matrix_t
                        Eintraegen bis zu Zeile i-1. 
                        D.h. werte[zeilen_akk[i]] ist der erste nicht-null Eintrag
                        in Zeile i. */
+  int befuellt; /* Ist 1, sobald alle nnE Eintraege mit joelix_smatrix_fuelleZeile
+                   eingetragen sind. Waehrend des Befuellens steht in zeilen_akk[n]
+                   die zuletzt befuellte Zeile, daran laesst sich das nicht
+                   erkennen. */
   int * spalten_ind; /* Hat Laenge nnE. An Stelle i steht der Spaltenindex des i-ten
                         Elementes in werte, also des i-ten nicht-null Elements. */
+  struct Joelix_Muster_t * muster; /* Das gemeinsame Muster oder NULL. Ist es
+                                      gesetzt, zeigen zeilen_akk und spalten_ind
+                                      in das Muster und gehoeren nicht der Matrix. */
+
+  /* Der von joelix_smatrix_optimieren ausgewaehlte SpMV-Kernel */
+  int kernel;  /* Ein Wert aus Joelix_SpMV_Kernel. */
+  int threads; /* Anzahl der Threads von kontext, die rechnen. */
+  struct Joelix_Kontext_t * kontext; /* Nur bei threads > 1 gesetzt. */
+  int * grenzen; /* Hat Laenge threads+1. Thread t bearbeitet die Zeilen
+                    grenzen[t] <= i < grenzen[t+1]. Die Zeilen sind so
+                    aufgeteilt, dass jeder Thread etwa gleich viele
+                    nicht-null Eintraege hat. */
+  int ell_breite; /* Nur fuer JOELIX_SPMV_ELL: Laenge der laengsten Zeile */
+  double * ell_werte; /* Hat Laenge ell_breite*n. Eintrag j von Zeile i steht
+                         an Stelle j*n+i, kuerzere Zeilen sind mit 0 aufgefuellt. */
+  int * ell_spalten;  /* Wie ell_werte, die Spaltenindices. */
+
+  /* Der Spaltenzugriff (CSC) fuer joelix_smatvec_delta. Wird erst bei Bedarf
+     aufgebaut und verworfen, wenn sich das Muster aendert. Gespeichert wird
+     nicht der Wert, sondern seine Stelle in werte, so dass geaenderte Werte
+     den Spaltenzugriff nicht ungueltig machen. */
+  int * csc_akk;    /* NULL oder Laenge m+1, wie zeilen_akk fuer die Spalten */
+  int * csc_zeilen; /* Hat Laenge nnE, die Zeilenindices, spaltenweise */
+  int * csc_stelle; /* Hat Laenge nnE, die Stelle des Eintrags in werte */
 };
 
+/* Setzt den Kernel einer Matrix auf JOELIX_SPMV_CSR ohne Threads zurueck und
+   gibt den zusaetzlichen Speicher frei. */
+void joelix_smatrix_kernel_zuruecksetzen (struct Joelix_sparse_Matrix_t * M);
+
+/* Prueft, ob alle nicht-null Eintraege eingetragen wurden. Erst dann ist
+   zeilen_akk vollstaendig. */
+int joelix_smatrix_ist_befuellt (struct Joelix_sparse_Matrix_t * M);
+
+/* Baut den Spaltenzugriff von M auf, falls es ihn noch nicht gibt. */
+Joelix_Fehler joelix_smatrix_spalten_aufbauen (struct Joelix_sparse_Matrix_t * M);
+
+/* Gibt den Spaltenzugriff von M frei. */
+void joelix_smatrix_spalten_verwerfen (struct Joelix_sparse_Matrix_t * M);
+
+/* Berechnet b = Mx mit dem ausgewaehlten Kernel von M. Gibt F_THREAD_FEHLER
+   zurueck, wenn M mehrere Threads benutzt und aus einem davon aufgerufen
+   wird. */
+Joelix_Fehler joelix_smatvec_optimiert (double * b, struct Joelix_sparse_Matrix_t * M,
+                                        const double * x);
+
+/* Berechnet Y = MX fuer nvek Vektoren auf einmal. X und Y sind zeilenweise
+   gespeichert: Eintrag i von Vektor v steht an Stelle i*nvek+v. So wird jeder
+   Eintrag der Matrix nur einmal gelesen. */
+void joelix_smatvec_mehrfach (double * Y, struct Joelix_sparse_Matrix_t * M,
+                              const double * X, int nvek);
+
 /* Ein detailierter Output auf der Konsole zum debuggen */
 Joelix_Fehler joelix_smatrix_print_debug (struct Joelix_sparse_Matrix_t * M);
 
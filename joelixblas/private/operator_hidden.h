@@ -0,0 +1,54 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_OPERATOR_HIDDEN_H__
+#define __JOELIX_OPERATOR_HIDDEN_H__
+
+#include "joelix_error.h"
+#include "matrix_hidden.h"
+#include "operator.h"
+
+struct Joelix_Operator_t
+{
+  int n, m; /* Zeilen und Spaltenanzahl */
+  Joelix_Operator_Funktion anwenden;   /* y = Ax */
+  Joelix_Operator_Mehrfach mehrfach;   /* Y = AX fuer mehrere Vektoren oder NULL */
+  void * daten;                        /* Wird an anwenden und mehrfach uebergeben */
+  void (*befreien) (void *daten);      /* Gibt daten frei, oder NULL, wenn daten
+                                          nicht dem Operator gehoert */
+};
+
+/* Fuellt A als Operator fuer die Matrix M, ohne Speicher zu allozieren. So
+   koennen Funktionen, die eine Joelix_sMatrix bekommen, intern mit
+   Operatoren arbeiten. */
+void joelix_operator_smatrix_setzen (struct Joelix_Operator_t * A,
+                                     struct Joelix_sparse_Matrix_t * M);
+
+/* Berechnet Y = AX fuer nvek Vektoren. X und Y sind zeilenweise
+   gespeichert wie bei joelix_smatvec_mehrfach. Hat A keine eigene Funktion
+   dafuer, wird A auf jeden Vektor einzeln angewendet. */
+Joelix_Fehler joelix_operator_mehrfach (double * Y, struct Joelix_Operator_t * A,
+                                        const double * X, int nvek);
+
+#endif
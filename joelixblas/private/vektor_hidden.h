@@ -25,10 +25,25 @@
 #ifndef __JOELIX_VEKTOR_HIDDEN_H__
 #define __JOELIX_VEKTOR_HIDDEN_H__
 
+#include <stddef.h>
+#include "joelix_error.h"
+
 struct Joelix_Vektor_t
 {
  int laenge;
  double * werte;
+ /* Ist der Vektor mit joelix_vektor_lesen aus einer Datei abgebildet
+    (mmap), steht hier der Anfang und die Laenge der Abbildung. Sonst ist
+    abbildung NULL und werte wurde mit malloc angelegt. */
+ void * abbildung;
+ size_t abbildung_laenge;
 };
 
+/* Schreibe x als Text in eine Datei, ein Eintrag pro Zeile mit der kuerzesten
+   Darstellung, die beim Einlesen wieder genau x ergibt. Ist mit_stelle nicht
+   0, steht vor jedem Eintrag noch i/(n-1) (Format von
+   joelix_vektor_print_tofile). */
+Joelix_Fehler joelix_vektor_text_ausgeben (struct Joelix_Vektor_t *x, const char *dateiname,
+                                           int mit_stelle);
+
 #endif
@@ -0,0 +1,77 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#ifndef __JOELIX_VERTEILT_HIDDEN_H__
+#define __JOELIX_VERTEILT_HIDDEN_H__
+
+#include <mpi.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "matrix_hidden.h"
+
+struct Joelix_vVektor_t
+{
+  MPI_Comm comm;
+  int n;        /* Globale Laenge */
+  int anfang;   /* Globaler Index des ersten lokalen Eintrags */
+  struct Joelix_Vektor_t * lokal; /* Die lokalen Eintraege */
+};
+
+struct Joelix_vsMatrix_t
+{
+  MPI_Comm comm;
+  int rang, nraenge;
+  int n;        /* Globale Zeilen- und Spaltenanzahl */
+  int nlokal;   /* Anzahl der lokalen Zeilen */
+  int * anfaenge; /* Hat Laenge nraenge+1. Rang r besitzt die Zeilen
+                     anfaenge[r] <= i < anfaenge[r+1]. */
+
+  /* Bis zum Aufruf von joelix_vsmatrix_aufbauen: Die lokalen Zeilen mit
+     globalen Spaltenindices. Danach NULL. */
+  struct Joelix_sparse_Matrix_t * global;
+
+  /* Nach joelix_vsmatrix_aufbauen */
+  struct Joelix_sparse_Matrix_t * diag; /* nlokal x nlokal, lokale Spalten */
+  struct Joelix_sparse_Matrix_t * offd; /* nlokal x ngeist, Spalten sind
+                                           Indices in geist_werte */
+  int ngeist;          /* Anzahl der benoetigten Eintraege anderer Raenge */
+  int * geist_global;  /* Hat Laenge ngeist. Die globalen Indices, aufsteigend
+                          sortiert. Damit liegen die Eintraege jedes Nachbarn
+                          zusammenhaengend. */
+  double * geist_werte; /* Hat Laenge ngeist. Empfangspuffer */
+
+  int nempfang;          /* Anzahl der Raenge, von denen wir empfangen */
+  int * empfang_rang;    /* Hat Laenge nempfang */
+  int * empfang_anfang;  /* Hat Laenge nempfang+1. Bereich in geist_werte */
+
+  int nsende;            /* Anzahl der Raenge, an die wir senden */
+  int * sende_rang;      /* Hat Laenge nsende */
+  int * sende_anfang;    /* Hat Laenge nsende+1. Bereich in sende_ind */
+  int * sende_ind;       /* Lokale Indices der zu sendenden Eintraege */
+  double * sende_werte;  /* Sendepuffer */
+
+  MPI_Request * anfragen; /* Hat Laenge nempfang + nsende */
+};
+
+#endif
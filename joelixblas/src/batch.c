@@ -0,0 +1,620 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "joelix_error.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
+#include "batch_hidden.h"
+#include "batch.h"
+
+extern Joelix_Fehler joelix_fehler_code;
+
+/* Pruefe ein CSR Muster mit n Zeilen und nnE Eintraegen */
+static int joelix_batch_muster_ok (int n, int nnE, const int *zeilen_akk, const int *spalten_ind)
+{
+  int i, k;
+
+  if (zeilen_akk == NULL || (nnE > 0 && spalten_ind == NULL)) return 0;
+  if (zeilen_akk[0] != 0 || zeilen_akk[n] != nnE) return 0;
+  for (i = 0;i < n;i++) {
+    if (zeilen_akk[i + 1] < zeilen_akk[i]) return 0;
+  }
+  for (k = 0;k < nnE;k++) {
+    if (spalten_ind[k] < 0 || spalten_ind[k] >= n) return 0;
+  }
+  return 1;
+}
+
+static void joelix_batch_befreien (struct Joelix_Batch_t *B)
+{
+  free (B->zeilen_akk);
+  free (B->spalten_ind);
+  free (B->sys_n);
+  free (B->sys_zeilen);
+  free (B->sys_eintraege);
+  free (B->werte);
+  free (B);
+}
+
+/* Batch mit gemeinsamem Muster */
+Joelix_Fehler joelix_batch_init_muster (Joelix_Batch *pBatch, int nsys, int n, int nnE,
+                                        const int *zeilen_akk, const int *spalten_ind)
+{
+  struct Joelix_Batch_t *B;
+
+  if (pBatch == NULL || nsys < 0 || n < 0 || nnE < 0
+      || !joelix_batch_muster_ok (n, nnE, zeilen_akk, spalten_ind)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  B = calloc (1, sizeof (*B));
+  if (B == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  B->nsys = nsys;
+  B->gemeinsam = 1;
+  B->nmax = n;
+  B->n = n;
+  B->nnE = nnE;
+  B->nblock = (nsys + JOELIX_BATCH_BREITE - 1) / JOELIX_BATCH_BREITE;
+  B->zeilen_akk = malloc ((n + 1) * sizeof (*B->zeilen_akk));
+  B->spalten_ind = malloc ((nnE > 0 ? nnE : 1) * sizeof (*B->spalten_ind));
+  B->werte = calloc ((size_t) B->nblock * nnE * JOELIX_BATCH_BREITE + 1, sizeof (*B->werte));
+  if (B->zeilen_akk == NULL || B->spalten_ind == NULL || B->werte == NULL) {
+    joelix_batch_befreien (B);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  memcpy (B->zeilen_akk, zeilen_akk, (n + 1) * sizeof (*B->zeilen_akk));
+  memcpy (B->spalten_ind, spalten_ind, nnE * sizeof (*B->spalten_ind));
+  *pBatch = B;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Batch mit verschiedenen Mustern */
+Joelix_Fehler joelix_batch_init (Joelix_Batch *pBatch, int nsys, const int *n, const int *nnE)
+{
+  struct Joelix_Batch_t *B;
+  int s;
+
+  if (pBatch == NULL || nsys < 0 || (nsys > 0 && (n == NULL || nnE == NULL))) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  for (s = 0;s < nsys;s++) {
+    if (n[s] < 0 || nnE[s] < 0) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  B = calloc (1, sizeof (*B));
+  if (B == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  B->nsys = nsys;
+  B->gemeinsam = 0;
+  B->sys_n = malloc ((nsys > 0 ? nsys : 1) * sizeof (*B->sys_n));
+  B->sys_zeilen = malloc ((nsys + 1) * sizeof (*B->sys_zeilen));
+  B->sys_eintraege = malloc ((nsys + 1) * sizeof (*B->sys_eintraege));
+  if (B->sys_n == NULL || B->sys_zeilen == NULL || B->sys_eintraege == NULL) {
+    joelix_batch_befreien (B);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  B->sys_zeilen[0] = 0;
+  B->sys_eintraege[0] = 0;
+  for (s = 0;s < nsys;s++) {
+    B->sys_n[s] = n[s];
+    B->sys_zeilen[s + 1] = B->sys_zeilen[s] + n[s];
+    B->sys_eintraege[s + 1] = B->sys_eintraege[s] + nnE[s];
+    if (n[s] > B->nmax) B->nmax = n[s];
+  }
+  /* Ohne joelix_batch_setze_system sind alle Zeilen leer */
+  B->zeilen_akk = calloc (B->sys_zeilen[nsys] + nsys + 1, sizeof (*B->zeilen_akk));
+  B->spalten_ind = calloc (B->sys_eintraege[nsys] + 1, sizeof (*B->spalten_ind));
+  B->werte = calloc (B->sys_eintraege[nsys] + 1, sizeof (*B->werte));
+  if (B->zeilen_akk == NULL || B->spalten_ind == NULL || B->werte == NULL) {
+    joelix_batch_befreien (B);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  *pBatch = B;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Muster und Werte eines Systems setzen */
+Joelix_Fehler joelix_batch_setze_system (Joelix_Batch B, int s, const int *zeilen_akk,
+                                         const int *spalten_ind, const double *werte)
+{
+  int n, nnE;
+
+  if (B == NULL || B->gemeinsam || s < 0 || s >= B->nsys) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  n = B->sys_n[s];
+  nnE = (int) (B->sys_eintraege[s + 1] - B->sys_eintraege[s]);
+  if (!joelix_batch_muster_ok (n, nnE, zeilen_akk, spalten_ind)
+      || (nnE > 0 && werte == NULL)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  memcpy (B->zeilen_akk + B->sys_zeilen[s] + s, zeilen_akk, (n + 1) * sizeof (*zeilen_akk));
+  memcpy (B->spalten_ind + B->sys_eintraege[s], spalten_ind, nnE * sizeof (*spalten_ind));
+  memcpy (B->werte + B->sys_eintraege[s], werte, nnE * sizeof (*werte));
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Nur die Werte eines Systems setzen */
+Joelix_Fehler joelix_batch_setze_werte (Joelix_Batch B, int s, const double *werte)
+{
+  double *w;
+  int k;
+
+  if (B == NULL || s < 0 || s >= B->nsys || werte == NULL) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (B->gemeinsam) {
+    w = B->werte + (long) (s / JOELIX_BATCH_BREITE) * B->nnE * JOELIX_BATCH_BREITE
+      + s % JOELIX_BATCH_BREITE;
+    for (k = 0;k < B->nnE;k++) w[(long) k * JOELIX_BATCH_BREITE] = werte[k];
+  } else {
+    memcpy (B->werte + B->sys_eintraege[s], werte,
+            (B->sys_eintraege[s + 1] - B->sys_eintraege[s]) * sizeof (*werte));
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+int joelix_batch_systeme (Joelix_Batch B)
+{
+  if (B == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return B->nsys;
+}
+
+Joelix_Fehler joelix_batch_loeschen (Joelix_Batch *pBatch)
+{
+  if (pBatch == NULL || *pBatch == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_batch_befreien (*pBatch);
+  *pBatch = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Die Vektoren */
+Joelix_Fehler joelix_batch_vektor_init (Joelix_Batch_Vektor *pVektor, Joelix_Batch B)
+{
+  struct Joelix_Batch_Vektor_t *V;
+
+  if (pVektor == NULL || B == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  V = calloc (1, sizeof (*V));
+  if (V == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  V->nsys = B->nsys;
+  V->gemeinsam = B->gemeinsam;
+  if (B->gemeinsam) {
+    V->n = B->n;
+    V->laenge = (long) B->nblock * B->n * JOELIX_BATCH_BREITE;
+  } else {
+    V->anfang = malloc ((B->nsys + 1) * sizeof (*V->anfang));
+    if (V->anfang == NULL) {
+      free (V);
+      return (joelix_fehler_code = F_KEIN_SPEICHER);
+    }
+    memcpy (V->anfang, B->sys_zeilen, (B->nsys + 1) * sizeof (*V->anfang));
+    V->laenge = B->sys_zeilen[B->nsys];
+  }
+  V->werte = calloc (V->laenge + 1, sizeof (*V->werte));
+  if (V->werte == NULL) {
+    free (V->anfang);
+    free (V);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  *pVektor = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_batch_vektor_null (Joelix_Batch_Vektor x)
+{
+  if (x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  memset (x->werte, 0, x->laenge * sizeof (*x->werte));
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Anzahl der Eintraege von System s */
+static int joelix_batch_vektor_n (const struct Joelix_Batch_Vektor_t *x, int s)
+{
+  return x->gemeinsam ? x->n : (int) (x->anfang[s + 1] - x->anfang[s]);
+}
+
+/* Position von Eintrag i von System s in x->werte */
+static long joelix_batch_vektor_index (const struct Joelix_Batch_Vektor_t *x, int s, int i)
+{
+  if (x->gemeinsam) {
+    return ((long) (s / JOELIX_BATCH_BREITE) * x->n + i) * JOELIX_BATCH_BREITE
+      + s % JOELIX_BATCH_BREITE;
+  }
+  return x->anfang[s] + i;
+}
+
+Joelix_Fehler joelix_batch_vektor_seti (Joelix_Batch_Vektor x, int s, int i, double wert)
+{
+  if (x == NULL || s < 0 || s >= x->nsys) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (i < 0 || i >= joelix_batch_vektor_n (x, s)) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  x->werte[joelix_batch_vektor_index (x, s, i)] = wert;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_batch_vektor_geti (Joelix_Batch_Vektor x, int s, int i, double *wert)
+{
+  if (x == NULL || wert == NULL || s < 0 || s >= x->nsys) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (i < 0 || i >= joelix_batch_vektor_n (x, s)) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  *wert = x->werte[joelix_batch_vektor_index (x, s, i)];
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_batch_vektor_setze_system (Joelix_Batch_Vektor x, int s,
+                                                const double *werte)
+{
+  double *w;
+  int i, n;
+
+  if (x == NULL || werte == NULL || s < 0 || s >= x->nsys) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  n = joelix_batch_vektor_n (x, s);
+  w = x->werte + joelix_batch_vektor_index (x, s, 0);
+  if (x->gemeinsam) {
+    for (i = 0;i < n;i++) w[(long) i * JOELIX_BATCH_BREITE] = werte[i];
+  } else {
+    memcpy (w, werte, n * sizeof (*werte));
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_batch_vektor_hole_system (Joelix_Batch_Vektor x, int s, double *werte)
+{
+  const double *w;
+  int i, n;
+
+  if (x == NULL || werte == NULL || s < 0 || s >= x->nsys) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  n = joelix_batch_vektor_n (x, s);
+  w = x->werte + joelix_batch_vektor_index (x, s, 0);
+  if (x->gemeinsam) {
+    for (i = 0;i < n;i++) werte[i] = w[(long) i * JOELIX_BATCH_BREITE];
+  } else {
+    memcpy (werte, w, n * sizeof (*werte));
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_batch_vektor_loeschen (Joelix_Batch_Vektor *pVektor)
+{
+  if (pVektor == NULL || *pVektor == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  free ((*pVektor)->anfang);
+  free ((*pVektor)->werte);
+  free (*pVektor);
+  *pVektor = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Passt die Speicheranordnung von x zu B? */
+static int joelix_batch_passt (const struct Joelix_Batch_t *B,
+                               const struct Joelix_Batch_Vektor_t *x)
+{
+  if (x == NULL || x->nsys != B->nsys || x->gemeinsam != B->gemeinsam) return 0;
+  if (B->gemeinsam) return x->n == B->n;
+  return memcmp (x->anfang, B->sys_zeilen, (B->nsys + 1) * sizeof (*x->anfang)) == 0;
+}
+
+/* Die Rechnungen laufen ueber Einheiten: bei gemeinsamem Muster ist eine
+   Einheit ein Block von JOELIX_BATCH_BREITE Systemen, sonst ein System. */
+static int joelix_batch_einheiten (const struct Joelix_Batch_t *B)
+{
+  return B->gemeinsam ? B->nblock : B->nsys;
+}
+
+/* Zeilenanzahl, Breite und Anfang im Batch-Vektor von Einheit e */
+static void joelix_batch_einheit (const struct Joelix_Batch_t *B, int e, int *n, int *breite,
+                                  long *anfang)
+{
+  if (B->gemeinsam) {
+    *n = B->n;
+    *breite = JOELIX_BATCH_BREITE;
+    *anfang = (long) e * B->n * JOELIX_BATCH_BREITE;
+  } else {
+    *n = B->sys_n[e];
+    *breite = 1;
+    *anfang = B->sys_zeilen[e];
+  }
+}
+
+/* y = B_e x fuer Einheit e. x und y zeigen auf den Anfang der Einheit. */
+static void joelix_batch_spmv_einheit (const struct Joelix_Batch_t *B, int e, const double *x,
+                                       double *y)
+{
+  const double *w, *wk, *xk;
+  const int *za, *sp;
+  double summe[JOELIX_BATCH_BREITE], s;
+  int i, k, l, n;
+
+  if (B->gemeinsam) {
+    /* Die Schleife ueber l laeuft ueber 8 Systeme mit gleichem Muster */
+    w = B->werte + (long) e * B->nnE * JOELIX_BATCH_BREITE;
+    for (i = 0;i < B->n;i++) {
+      for (l = 0;l < JOELIX_BATCH_BREITE;l++) summe[l] = 0;
+      for (k = B->zeilen_akk[i];k < B->zeilen_akk[i + 1];k++) {
+        wk = w + (long) k * JOELIX_BATCH_BREITE;
+        xk = x + (long) B->spalten_ind[k] * JOELIX_BATCH_BREITE;
+        for (l = 0;l < JOELIX_BATCH_BREITE;l++) summe[l] += wk[l] * xk[l];
+      }
+      for (l = 0;l < JOELIX_BATCH_BREITE;l++) y[(long) i * JOELIX_BATCH_BREITE + l] = summe[l];
+    }
+  } else {
+    n = B->sys_n[e];
+    za = B->zeilen_akk + B->sys_zeilen[e] + e;
+    sp = B->spalten_ind + B->sys_eintraege[e];
+    w = B->werte + B->sys_eintraege[e];
+    for (i = 0;i < n;i++) {
+      s = 0;
+      for (k = za[i];k < za[i + 1];k++) s += w[k] * x[sp[k]];
+      y[i] = s;
+    }
+  }
+}
+
+/* Die Argumente von joelix_batch_smatvec_aufgabe */
+struct joelix_batch_spmv_aufgabe
+{
+  const struct Joelix_Batch_t *B;
+  const double *x;
+  double *y;
+};
+
+static void joelix_batch_smatvec_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_batch_spmv_aufgabe *a = daten;
+  int e, anfang, ende, n, breite;
+  long pos;
+
+  joelix_kontext_bereich (joelix_batch_einheiten (a->B), tid, nthreads, &anfang, &ende);
+  for (e = anfang;e < ende;e++) {
+    joelix_batch_einheit (a->B, e, &n, &breite, &pos);
+    joelix_batch_spmv_einheit (a->B, e, a->x + pos, a->y + pos);
+  }
+}
+
+/* y = B x fuer alle Systeme */
+Joelix_Fehler joelix_batch_smatvec (Joelix_Batch_Vektor y, Joelix_Batch B, Joelix_Batch_Vektor x,
+                                    Joelix_Kontext K)
+{
+  struct joelix_batch_spmv_aufgabe a;
+
+  if (B == NULL || x == NULL || y == NULL || x == y) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (!joelix_batch_passt (B, x) || !joelix_batch_passt (B, y)) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  a.B = B;
+  a.x = x->werte;
+  a.y = y->werte;
+  if (K != NULL) {
+    if (joelix_kontext_ausfuehren (K, joelix_batch_smatvec_aufgabe, &a) != F_ERFOLG) {
+      return joelix_fehler_code;
+    }
+  } else {
+    joelix_batch_smatvec_aufgabe (&a, 0, 1);
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Skalarprodukte der breite Systeme einer Einheit: d[l] = sum_i u_il v_il */
+static void joelix_batch_dot (double *d, const double *u, const double *v, int n, int breite)
+{
+  int i, l;
+
+  for (l = 0;l < breite;l++) d[l] = 0;
+  for (i = 0;i < n;i++) {
+    for (l = 0;l < breite;l++) d[l] += u[(long) i * breite + l] * v[(long) i * breite + l];
+  }
+}
+
+/* CG fuer Einheit e. Die Systeme einer Einheit werden gemeinsam iteriert,
+   ein konvergiertes System bekommt alpha = 0 und aendert sich nicht mehr.
+   r, p und q sind Arbeitsspeicher der Laenge n*breite. In ok und it stehen
+   danach fuer jedes System der Einheit Konvergenz und Iterationen. Gibt die
+   Anzahl der nicht konvergierten Systeme zurueck. */
+static int joelix_batch_cg_einheit (const struct Joelix_Batch_t *B, int e, const double *b,
+                                    double *x, double *r, double *p, double *q, double tol,
+                                    int maxiter, int *ok, int *it)
+{
+  double rr[JOELIX_BATCH_BREITE], bb[JOELIX_BATCH_BREITE], pq[JOELIX_BATCH_BREITE];
+  double alpha[JOELIX_BATCH_BREITE], beta[JOELIX_BATCH_BREITE];
+  int aktiv[JOELIX_BATCH_BREITE];
+  int i, l, k, n, breite, nsys, naktiv = 0, fehlt = 0;
+  long pos, m;
+
+  joelix_batch_einheit (B, e, &n, &breite, &pos);
+  m = (long) n * breite;
+  /* Anzahl der echten Systeme, der letzte Block kann aufgefuellt sein */
+  nsys = B->gemeinsam ? B->nsys - e * JOELIX_BATCH_BREITE : 1;
+  if (nsys > breite) nsys = breite;
+
+  /* r = b - Ax, p = r */
+  joelix_batch_spmv_einheit (B, e, x, q);
+  for (i = 0;i < m;i++) {
+    r[i] = b[i] - q[i];
+    p[i] = r[i];
+  }
+  joelix_batch_dot (rr, r, r, n, breite);
+  joelix_batch_dot (bb, b, b, n, breite);
+  for (l = 0;l < breite;l++) {
+    ok[l] = 0;
+    it[l] = 0;
+    aktiv[l] = 0;
+    if (l >= nsys) continue;
+    if (bb[l] == 0) {
+      /* b = 0 hat die Loesung x = 0 */
+      for (i = 0;i < n;i++) x[(long) i * breite + l] = 0;
+      ok[l] = 1;
+    } else if (rr[l] <= tol * tol * bb[l]) {
+      ok[l] = 1;
+    } else {
+      aktiv[l] = 1;
+      naktiv++;
+    }
+  }
+
+  for (k = 0;k < maxiter && naktiv > 0;k++) {
+    joelix_batch_spmv_einheit (B, e, p, q);
+    joelix_batch_dot (pq, p, q, n, breite);
+    for (l = 0;l < breite;l++) {
+      alpha[l] = 0;
+      if (!aktiv[l]) continue;
+      if (pq[l] > 0) {
+        alpha[l] = rr[l] / pq[l];
+      } else {
+        /* Matrix nicht positiv definit, System gibt auf */
+        aktiv[l] = 0;
+        naktiv--;
+      }
+    }
+    for (i = 0;i < n;i++) {
+      for (l = 0;l < breite;l++) {
+        x[(long) i * breite + l] += alpha[l] * p[(long) i * breite + l];
+        r[(long) i * breite + l] -= alpha[l] * q[(long) i * breite + l];
+      }
+    }
+    joelix_batch_dot (pq, r, r, n, breite);
+    for (l = 0;l < breite;l++) {
+      beta[l] = 0;
+      if (!aktiv[l]) continue;
+      it[l] = k + 1;
+      if (pq[l] <= tol * tol * bb[l]) {
+        ok[l] = 1;
+        aktiv[l] = 0;
+        naktiv--;
+      } else {
+        beta[l] = pq[l] / rr[l];
+        rr[l] = pq[l];
+      }
+    }
+    for (i = 0;i < n;i++) {
+      for (l = 0;l < breite;l++) {
+        p[(long) i * breite + l] = r[(long) i * breite + l] + beta[l] * p[(long) i * breite + l];
+      }
+    }
+  }
+  for (l = 0;l < nsys;l++) {
+    if (!ok[l]) fehlt++;
+  }
+  return fehlt;
+}
+
+/* Die Argumente von joelix_batch_cg_aufgabe. Die Threads holen sich die
+   Einheiten ueber naechste einzeln ab. */
+struct joelix_batch_cg_aufgabe
+{
+  const struct Joelix_Batch_t *B;
+  const double *b;
+  double *x;
+  double *arbeit;  /* Pro Thread 3 * nmax * JOELIX_BATCH_BREITE */
+  double tol;
+  int maxiter;
+  int *konvergiert;
+  int *iterationen;
+  pthread_mutex_t mutex;
+  int naechste;
+  int fehlt;
+};
+
+static void joelix_batch_cg_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_batch_cg_aufgabe *a = daten;
+  const struct Joelix_Batch_t *B = a->B;
+  int ok[JOELIX_BATCH_BREITE], it[JOELIX_BATCH_BREITE];
+  int e, l, s, n, breite, fehlt = 0, neinheiten = joelix_batch_einheiten (B);
+  long pos, m = (long) B->nmax * JOELIX_BATCH_BREITE;
+  double *r = a->arbeit + 3 * m * tid;
+
+  (void) nthreads;
+  for (;;) {
+    pthread_mutex_lock (&a->mutex);
+    e = a->naechste++;
+    pthread_mutex_unlock (&a->mutex);
+    if (e >= neinheiten) break;
+    joelix_batch_einheit (B, e, &n, &breite, &pos);
+    fehlt += joelix_batch_cg_einheit (B, e, a->b + pos, a->x + pos, r, r + m, r + 2 * m,
+                                      a->tol, a->maxiter, ok, it);
+    for (l = 0;l < breite;l++) {
+      s = e * breite + l;
+      if (s >= B->nsys) break;
+      if (a->konvergiert != NULL) a->konvergiert[s] = ok[l];
+      if (a->iterationen != NULL) a->iterationen[s] = it[l];
+    }
+  }
+  pthread_mutex_lock (&a->mutex);
+  a->fehlt += fehlt;
+  pthread_mutex_unlock (&a->mutex);
+}
+
+/* CG fuer alle Systeme */
+Joelix_Fehler joelix_batch_cg (Joelix_Batch B, Joelix_Batch_Vektor b, Joelix_Batch_Vektor x,
+                               double tol, int maxiter, Joelix_Kontext K, int *konvergiert,
+                               int *iterationen)
+{
+  struct joelix_batch_cg_aufgabe a;
+  int nthreads;
+  Joelix_Fehler fehler;
+
+  if (B == NULL || b == NULL || x == NULL || b == x || tol < 0 || maxiter < 0) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (!joelix_batch_passt (B, b) || !joelix_batch_passt (B, x)) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  nthreads = (K != NULL ? K->nthreads : 1);
+  a.arbeit = malloc (((size_t) 3 * nthreads * B->nmax * JOELIX_BATCH_BREITE + 1)
+                     * sizeof (*a.arbeit));
+  if (a.arbeit == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  if (pthread_mutex_init (&a.mutex, NULL) != 0) {
+    free (a.arbeit);
+    return (joelix_fehler_code = F_THREAD_FEHLER);
+  }
+  a.B = B;
+  a.b = b->werte;
+  a.x = x->werte;
+  a.tol = tol;
+  a.maxiter = maxiter;
+  a.konvergiert = konvergiert;
+  a.iterationen = iterationen;
+  a.naechste = 0;
+  a.fehlt = 0;
+  fehler = F_ERFOLG;
+  if (K != NULL) {
+    fehler = joelix_kontext_ausfuehren (K, joelix_batch_cg_aufgabe, &a);
+  } else {
+    joelix_batch_cg_aufgabe (&a, 0, 1);
+  }
+  pthread_mutex_destroy (&a.mutex);
+  free (a.arbeit);
+  if (fehler != F_ERFOLG) return (joelix_fehler_code = fehler);
+  if (a.fehlt > 0) return (joelix_fehler_code = F_CG_TERMINIERT_NICHT);
+  return (joelix_fehler_code = F_ERFOLG);
+}
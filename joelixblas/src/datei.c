@@ -0,0 +1,650 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+/* Fuer fileno, fsync und mmap */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <float.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "datei_hidden.h"
+#include "datei.h"
+
+extern Joelix_Fehler joelix_fehler_code;
+
+/* Groesse des Puffers fuer die Textein- und ausgabe */
+#define JOELIX_DATEI_PUFFER (1 << 20)
+/* Platz, den eine Zeile der Textausgabe hoechstens braucht: zwei Zahlen mit
+   17 Stellen, Exponent, Vorzeichen, Leerzeichen und Zeilenende */
+#define JOELIX_DATEI_ZEILE 64
+
+static const char joelix_kennung_vektor[8] = {'J', 'O', 'E', 'L', 'I', 'X', 'V', '\n'};
+static const char joelix_kennung_checkpoint[8] = {'J', 'O', 'E', 'L', 'I', 'X', 'C', '\n'};
+
+/* FNV-1a Pruefsumme, aber wortweise statt byteweise, damit grosse Vektoren
+   nicht merklich langsamer geschrieben und gelesen werden. */
+uint64_t joelix_pruefsumme (uint64_t h, const void *daten, size_t nworte)
+{
+  const unsigned char *p = daten;
+  uint64_t w;
+  size_t i;
+
+  for (i = 0;i < nworte;i++) {
+    memcpy (&w, p + 8 * i, 8);
+    h ^= w;
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+void joelix_kopf_init (struct joelix_datei_kopf *kopf, const char *kennung)
+{
+  memset (kopf, 0, sizeof (*kopf));
+  memcpy (kopf->kennung, kennung, 8);
+  kopf->version = JOELIX_DATEI_VERSION;
+  kopf->reihenfolge = JOELIX_DATEI_REIHENFOLGE;
+}
+
+int joelix_kopf_pruefen (const struct joelix_datei_kopf *kopf, const char *kennung)
+{
+  return memcmp (kopf->kennung, kennung, 8) == 0 && kopf->version == JOELIX_DATEI_VERSION
+    && kopf->reihenfolge == JOELIX_DATEI_REIHENFOLGE;
+}
+
+/* Lege einen Vektor fuer schon vorhandene Werte an */
+static struct Joelix_Vektor_t *joelix_vektor_anlegen (double *werte, int n, void *abbildung,
+                                                      size_t abbildung_laenge)
+{
+  struct Joelix_Vektor_t *V;
+
+  V = malloc (sizeof (*V));
+  if (V == NULL) return NULL;
+  V->laenge = n;
+  V->werte = werte;
+  V->abbildung = abbildung;
+  V->abbildung_laenge = abbildung_laenge;
+  return V;
+}
+
+/* Schreibe x binaer in eine Datei */
+Joelix_Fehler joelix_vektor_schreiben (Joelix_Vektor x, const char *dateiname)
+{
+  struct joelix_datei_kopf kopf;
+  FILE *file;
+  int ok;
+
+  if (x == NULL || dateiname == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_kopf_init (&kopf, joelix_kennung_vektor);
+  kopf.laenge = x->laenge;
+  kopf.pruefsumme = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, x->werte, x->laenge);
+  file = fopen (dateiname, "wb");
+  if (file == NULL) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  ok = fwrite (&kopf, sizeof (kopf), 1, file) == 1
+    && fwrite (x->werte, sizeof (*x->werte), x->laenge, file) == (size_t) x->laenge;
+  if (fclose (file) != 0) ok = 0;
+  if (!ok) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Bilde die Datei mit mmap ab, die Werte stehen direkt hinter dem Kopf */
+static Joelix_Fehler joelix_vektor_abbilden (Joelix_Vektor *pVektor, const char *dateiname,
+                                             int flags)
+{
+  struct joelix_datei_kopf kopf;
+  struct stat info;
+  struct Joelix_Vektor_t *V;
+  void *abbildung;
+  size_t groesse;
+  double *werte;
+  int fd;
+
+  fd = open (dateiname, O_RDONLY);
+  if (fd < 0) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  if (fstat (fd, &info) != 0) {
+    close (fd);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  groesse = info.st_size;
+  if (groesse < sizeof (kopf)) {
+    close (fd);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  /* MAP_PRIVATE: der Vektor darf veraendert werden, die Datei bleibt gleich */
+  abbildung = mmap (NULL, groesse, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (abbildung == MAP_FAILED) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  memcpy (&kopf, abbildung, sizeof (kopf));
+  if (!joelix_kopf_pruefen (&kopf, joelix_kennung_vektor) || kopf.laenge > INT_MAX
+      || groesse != sizeof (kopf) + kopf.laenge * sizeof (double)) {
+    munmap (abbildung, groesse);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  werte = (double *) ((char *) abbildung + sizeof (kopf));
+  if (!(flags & JOELIX_DATEI_UNGEPRUEFT)
+      && joelix_pruefsumme (JOELIX_PRUEFSUMME_START, werte, kopf.laenge) != kopf.pruefsumme) {
+    munmap (abbildung, groesse);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  V = joelix_vektor_anlegen (werte, (int) kopf.laenge, abbildung, groesse);
+  if (V == NULL) {
+    munmap (abbildung, groesse);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  *pVektor = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Lese einen binaer geschriebenen Vektor */
+Joelix_Fehler joelix_vektor_lesen (Joelix_Vektor *pVektor, const char *dateiname, int flags)
+{
+  struct joelix_datei_kopf kopf;
+  struct Joelix_Vektor_t *V;
+  double *werte;
+  FILE *file;
+  int n;
+
+  if (pVektor == NULL || dateiname == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (flags & JOELIX_DATEI_ABBILDEN) return joelix_vektor_abbilden (pVektor, dateiname, flags);
+
+  file = fopen (dateiname, "rb");
+  if (file == NULL) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  if (fread (&kopf, sizeof (kopf), 1, file) != 1
+      || !joelix_kopf_pruefen (&kopf, joelix_kennung_vektor) || kopf.laenge > INT_MAX) {
+    fclose (file);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  n = (int) kopf.laenge;
+  werte = malloc ((n > 0 ? n : 1) * sizeof (*werte));
+  if (werte == NULL) {
+    fclose (file);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  if (fread (werte, sizeof (*werte), n, file) != (size_t) n) {
+    free (werte);
+    fclose (file);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  fclose (file);
+  if (!(flags & JOELIX_DATEI_UNGEPRUEFT)
+      && joelix_pruefsumme (JOELIX_PRUEFSUMME_START, werte, n) != kopf.pruefsumme) {
+    free (werte);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  V = joelix_vektor_anlegen (werte, n, NULL, 0);
+  if (V == NULL) {
+    free (werte);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  *pVektor = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Der langsame, aber immer korrekte Weg: sprintf mit 15, 16 und 17 Stellen */
+static int joelix_zahl_sprintf (char *puffer, double wert)
+{
+  int stellen, laenge = 0;
+
+  for (stellen = 15;stellen <= 17;stellen++) {
+    laenge = sprintf (puffer, "%.*g", stellen, wert);
+    if (strtod (puffer, NULL) == wert) break;
+  }
+  return laenge;
+}
+
+/* Der schnelle Weg braucht long double mit mindestens 64 Bit Mantisse und
+   Exponenten bis 10^384 (x86) */
+#if LDBL_MANT_DIG >= 64 && LDBL_MAX_10_EXP >= 384
+
+/* Schreibe die p Ziffern von q (10^(p-1) <= q < 10^p) mit Dezimalexponent
+   e im Format von %g, d.h. ohne Nullen am Ende, ab e < -4 oder e >= p mit
+   Exponent. Gibt die Anzahl der geschriebenen Zeichen zurueck. */
+static int joelix_ziffern_ausgeben (char *puffer, int negativ, uint64_t q, int p, int e)
+{
+  char ziffern[20];
+  int i, k, pos = 0;
+
+  for (i = p - 1;i >= 0;i--) {
+    ziffern[i] = (char) ('0' + q % 10);
+    q /= 10;
+  }
+  k = p;
+  while (k > 1 && ziffern[k - 1] == '0') k--;
+  if (negativ) puffer[pos++] = '-';
+  if (e < -4 || e >= p) {
+    puffer[pos++] = ziffern[0];
+    if (k > 1) {
+      puffer[pos++] = '.';
+      for (i = 1;i < k;i++) puffer[pos++] = ziffern[i];
+    }
+    puffer[pos++] = 'e';
+    puffer[pos++] = (e < 0 ? '-' : '+');
+    if (e < 0) e = -e;
+    if (e >= 100) puffer[pos++] = (char) ('0' + e / 100);
+    puffer[pos++] = (char) ('0' + e / 10 % 10);
+    puffer[pos++] = (char) ('0' + e % 10);
+  } else if (e >= 0) {
+    for (i = 0;i <= e;i++) puffer[pos++] = (i < k ? ziffern[i] : '0');
+    if (k > e + 1) {
+      puffer[pos++] = '.';
+      for (i = e + 1;i < k;i++) puffer[pos++] = ziffern[i];
+    }
+  } else {
+    puffer[pos++] = '0';
+    puffer[pos++] = '.';
+    for (i = 0;i < -e - 1;i++) puffer[pos++] = '0';
+    for (i = 0;i < k;i++) puffer[pos++] = ziffern[i];
+  }
+  puffer[pos] = '\0';
+  return pos;
+}
+
+/* 10^k = joelix_zehn_grob[(k + 352) / 32] * joelix_zehn_fein[(k + 352) % 32]
+   fuer -352 <= k < 384. Die Literale werden vom Compiler korrekt gerundet. */
+static const long double joelix_zehn_grob[23] = {
+  1e-352L, 1e-320L, 1e-288L, 1e-256L, 1e-224L, 1e-192L, 1e-160L, 1e-128L,
+  1e-96L, 1e-64L, 1e-32L, 1e0L, 1e32L, 1e64L, 1e96L, 1e128L, 1e160L, 1e192L,
+  1e224L, 1e256L, 1e288L, 1e320L, 1e352L
+};
+static const long double joelix_zehn_fein[32] = {
+  1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L,
+  1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L,
+  1e23L, 1e24L, 1e25L, 1e26L, 1e27L, 1e28L, 1e29L, 1e30L, 1e31L
+};
+
+static long double joelix_zehnhoch (int k)
+{
+  return joelix_zehn_grob[(k + 352) / 32] * joelix_zehn_fein[(k + 352) % 32];
+}
+
+/* Runde die 17 Ziffern d (Exponent e) auf p Stellen und schreibe das
+   Ergebnis nach puffer. Gibt die Laenge zurueck, oder 0, wenn strtod damit
+   nicht wieder genau wert ergibt. */
+static int joelix_kandidat (char *puffer, double wert, uint64_t d, int e, int p)
+{
+  static const uint64_t zehn[3] = {100, 10, 1};
+  uint64_t q, teiler = zehn[p - 15];
+  int laenge;
+
+  q = (d + teiler / 2) / teiler;
+  if (q == 100000000000000000ULL / teiler) {
+    q /= 10;
+    e++;
+  }
+  laenge = joelix_ziffern_ausgeben (puffer, wert < 0, q, p, e);
+  return strtod (puffer, NULL) == wert ? laenge : 0;
+}
+
+/* Schreibe wert mit 15, 16 oder 17 Stellen, je nachdem wie viele noetig
+   sind, damit strtod wieder genau wert ergibt. Gibt die Anzahl der
+   geschriebenen Zeichen zurueck.
+   sprintf ist hierfuer zu langsam. Die 17 Ziffern werden deshalb mit long
+   double berechnet und daraus durch Runden die kuerzeren Kandidaten. Jeder
+   Kandidat wird mit strtod geprueft, passt keiner, wird doch sprintf
+   benutzt. Das Ergebnis ist also immer exakt, in seltenen Faellen
+   aber eine Stelle laenger als noetig. */
+static int joelix_zahl_formatieren (char *puffer, double wert)
+{
+  char kurz[32];
+  long double m;
+  uint64_t d;
+  int e, p, laenge;
+
+  if (wert == 0 || wert != wert || wert - wert != 0) {
+    /* Null, NaN und unendlich */
+    return joelix_zahl_sprintf (puffer, wert);
+  }
+  e = (int) floor (log10 (fabs (wert)));
+  m = fabsl ((long double) wert) * joelix_zehnhoch (16 - e);
+  d = (uint64_t) (m + 0.5L);
+  /* log10 kann an Zehnerpotenzen um eins daneben liegen */
+  if (d >= 100000000000000000ULL) {
+    e++;
+    d = (d + 5) / 10;
+  } else if (d < 10000000000000000ULL) {
+    e--;
+    m = fabsl ((long double) wert) * joelix_zehnhoch (16 - e);
+    d = (uint64_t) (m + 0.5L);
+  }
+  if (d < 10000000000000000ULL || d >= 100000000000000000ULL) {
+    return joelix_zahl_sprintf (puffer, wert);
+  }
+  /* Erst 16 Stellen, dann je nach Ergebnis 15 oder 17 */
+  laenge = joelix_kandidat (puffer, wert, d, e, 16);
+  if (laenge > 0) {
+    p = joelix_kandidat (kurz, wert, d, e, 15);
+    if (p > 0) {
+      memcpy (puffer, kurz, p + 1);
+      laenge = p;
+    }
+    return laenge;
+  }
+  laenge = joelix_kandidat (puffer, wert, d, e, 17);
+  if (laenge > 0) return laenge;
+  return joelix_zahl_sprintf (puffer, wert);
+}
+
+#else
+
+static int joelix_zahl_formatieren (char *puffer, double wert)
+{
+  return joelix_zahl_sprintf (puffer, wert);
+}
+
+#endif
+
+/* Die Textausgabe fuer joelix_vektor_text_schreiben und
+   joelix_vektor_print_tofile. Statt fprintf fuer jeden Eintrag werden die
+   Zeilen in einem grossen Puffer gesammelt und mit fwrite geschrieben. */
+Joelix_Fehler joelix_vektor_text_ausgeben (struct Joelix_Vektor_t *x, const char *dateiname,
+                                           int mit_stelle)
+{
+  FILE *file;
+  char *puffer;
+  size_t pos = 0;
+  int i, ok = 1;
+
+  puffer = malloc (JOELIX_DATEI_PUFFER);
+  if (puffer == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  file = fopen (dateiname, "w");
+  if (file == NULL) {
+    free (puffer);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  for (i = 0;i < x->laenge && ok;i++) {
+    if (mit_stelle) {
+      pos += joelix_zahl_formatieren (puffer + pos,
+                                      x->laenge > 1 ? ((double) i) / (x->laenge - 1) : 0.0);
+      puffer[pos++] = ' ';
+    }
+    pos += joelix_zahl_formatieren (puffer + pos, x->werte[i]);
+    puffer[pos++] = '\n';
+    if (pos > JOELIX_DATEI_PUFFER - JOELIX_DATEI_ZEILE) {
+      ok = fwrite (puffer, 1, pos, file) == pos;
+      pos = 0;
+    }
+  }
+  if (ok && pos > 0) ok = fwrite (puffer, 1, pos, file) == pos;
+  if (fclose (file) != 0) ok = 0;
+  free (puffer);
+  if (!ok) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Schreibe x als Text */
+Joelix_Fehler joelix_vektor_text_schreiben (Joelix_Vektor x, const char *dateiname)
+{
+  if (x == NULL || dateiname == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  return joelix_vektor_text_ausgeben (x, dateiname, 0);
+}
+
+/* Die gelesenen Werte von joelix_vektor_text_lesen */
+struct joelix_text_werte
+{
+  double *werte;
+  int n;
+  int kapazitaet;
+};
+
+/* Lese die letzte Zahl aus einer mit '\0' abgeschlossenen Zeile */
+static Joelix_Fehler joelix_zeile_lesen (struct joelix_text_werte *t, char *zeile)
+{
+  char *p, *ende;
+  double wert = 0, *neu;
+  int gefunden = 0;
+
+  p = zeile;
+  while (isspace ((unsigned char) *p)) p++;
+  if (*p == '\0' || *p == '#') return F_ERFOLG;
+  for (;;) {
+    double v = strtod (p, &ende);
+    if (ende == p) break;
+    wert = v;
+    gefunden = 1;
+    p = ende;
+  }
+  while (isspace ((unsigned char) *p)) p++;
+  if (!gefunden || *p != '\0') return F_DATEI_FORMAT;
+  if (t->n == t->kapazitaet) {
+    if (t->kapazitaet == INT_MAX) return F_DATEI_FORMAT;
+    t->kapazitaet = (t->kapazitaet > INT_MAX / 2 ? INT_MAX
+                     : (t->kapazitaet > 0 ? 2 * t->kapazitaet : 1024));
+    neu = realloc (t->werte, (size_t) t->kapazitaet * sizeof (*t->werte));
+    if (neu == NULL) return F_KEIN_SPEICHER;
+    t->werte = neu;
+  }
+  t->werte[t->n++] = wert;
+  return F_ERFOLG;
+}
+
+/* Lese einen Vektor als Text, blockweise mit einem grossen Puffer */
+Joelix_Fehler joelix_vektor_text_lesen (Joelix_Vektor *pVektor, const char *dateiname)
+{
+  struct joelix_text_werte t;
+  struct Joelix_Vektor_t *V;
+  Joelix_Fehler fehler = F_ERFOLG;
+  FILE *file;
+  char *puffer, *zeile, *nl;
+  size_t fuellung = 0, grenze, gelesen;
+  int ende_datei = 0;
+  double *neu;
+
+  if (pVektor == NULL || dateiname == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  puffer = malloc (JOELIX_DATEI_PUFFER + 1);
+  if (puffer == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  file = fopen (dateiname, "r");
+  if (file == NULL) {
+    free (puffer);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  t.werte = NULL;
+  t.n = 0;
+  t.kapazitaet = 0;
+  while (!ende_datei && fehler == F_ERFOLG) {
+    gelesen = fread (puffer + fuellung, 1, JOELIX_DATEI_PUFFER - fuellung, file);
+    if (gelesen < JOELIX_DATEI_PUFFER - fuellung) {
+      if (ferror (file)) {
+        fehler = F_FILEIO_FEHLER;
+        break;
+      }
+      ende_datei = 1;
+    }
+    fuellung += gelesen;
+    /* Nur vollstaendige Zeilen bearbeiten, der Rest kommt an den Anfang */
+    if (ende_datei) {
+      grenze = fuellung;
+    } else {
+      grenze = fuellung;
+      while (grenze > 0 && puffer[grenze - 1] != '\n') grenze--;
+      if (grenze == 0) {
+        /* Zeile laenger als der Puffer */
+        fehler = F_DATEI_FORMAT;
+        break;
+      }
+    }
+    zeile = puffer;
+    while (fehler == F_ERFOLG && zeile < puffer + grenze) {
+      nl = memchr (zeile, '\n', puffer + grenze - zeile);
+      if (nl == NULL) nl = puffer + grenze;
+      *nl = '\0';
+      fehler = joelix_zeile_lesen (&t, zeile);
+      zeile = nl + 1;
+    }
+    memmove (puffer, puffer + grenze, fuellung - grenze);
+    fuellung -= grenze;
+  }
+  fclose (file);
+  free (puffer);
+  if (fehler != F_ERFOLG) {
+    free (t.werte);
+    return (joelix_fehler_code = fehler);
+  }
+  /* Ueberzaehligen Speicher zurueckgeben */
+  neu = realloc (t.werte, (t.n > 0 ? t.n : 1) * sizeof (*t.werte));
+  if (neu == NULL) {
+    free (t.werte);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  V = joelix_vektor_anlegen (neu, t.n, NULL, 0);
+  if (V == NULL) {
+    free (neu);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  *pVektor = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Speichere den Zustand eines Verfahrens. Nach dem Kopf folgen die Laengen
+   der Vektoren, die Skalare und die Eintraege der Vektoren. */
+Joelix_Fehler joelix_checkpoint_schreiben (const char *dateiname, long iteration,
+                                           Joelix_Vektor *vektoren, int nvek,
+                                           const double *skalare, int nskalare)
+{
+  struct joelix_datei_kopf kopf;
+  uint64_t *laengen;
+  char *tmpname;
+  FILE *file;
+  int i, ok;
+
+  if (dateiname == NULL || nvek < 0 || nskalare < 0 || (nvek > 0 && vektoren == NULL)
+      || (nskalare > 0 && skalare == NULL)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  for (i = 0;i < nvek;i++) {
+    if (vektoren[i] == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  laengen = malloc ((nvek > 0 ? nvek : 1) * sizeof (*laengen));
+  tmpname = malloc (strlen (dateiname) + 5);
+  if (laengen == NULL || tmpname == NULL) {
+    free (laengen);
+    free (tmpname);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  sprintf (tmpname, "%s.tmp", dateiname);
+
+  joelix_kopf_init (&kopf, joelix_kennung_checkpoint);
+  kopf.laenge = nvek;
+  kopf.anzahl = nskalare;
+  kopf.iteration = iteration;
+  for (i = 0;i < nvek;i++) laengen[i] = vektoren[i]->laenge;
+  kopf.pruefsumme = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, laengen, nvek);
+  kopf.pruefsumme = joelix_pruefsumme (kopf.pruefsumme, skalare, nskalare);
+  for (i = 0;i < nvek;i++) {
+    kopf.pruefsumme = joelix_pruefsumme (kopf.pruefsumme, vektoren[i]->werte,
+                                         vektoren[i]->laenge);
+  }
+
+  file = fopen (tmpname, "wb");
+  if (file == NULL) {
+    free (laengen);
+    free (tmpname);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  ok = fwrite (&kopf, sizeof (kopf), 1, file) == 1
+    && fwrite (laengen, sizeof (*laengen), nvek, file) == (size_t) nvek
+    && fwrite (skalare, sizeof (*skalare), nskalare, file) == (size_t) nskalare;
+  for (i = 0;i < nvek && ok;i++) {
+    ok = fwrite (vektoren[i]->werte, sizeof (double), vektoren[i]->laenge, file)
+      == (size_t) vektoren[i]->laenge;
+  }
+  /* Erst auf die Platte bringen, dann den alten Checkpoint ersetzen */
+  if (ok) ok = fflush (file) == 0 && fsync (fileno (file)) == 0;
+  if (fclose (file) != 0) ok = 0;
+  if (ok) ok = rename (tmpname, dateiname) == 0;
+  if (!ok) remove (tmpname);
+  free (laengen);
+  free (tmpname);
+  if (!ok) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Lese einen Checkpoint */
+Joelix_Fehler joelix_checkpoint_lesen (const char *dateiname, long *iteration,
+                                       Joelix_Vektor *vektoren, int nvek,
+                                       double *skalare, int nskalare)
+{
+  struct joelix_datei_kopf kopf;
+  uint64_t *laengen, h;
+  double *s;
+  FILE *file;
+  int i, ok;
+
+  if (dateiname == NULL || iteration == NULL || nvek < 0 || nskalare < 0
+      || (nvek > 0 && vektoren == NULL) || (nskalare > 0 && skalare == NULL)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  for (i = 0;i < nvek;i++) {
+    if (vektoren[i] == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  file = fopen (dateiname, "rb");
+  if (file == NULL) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  if (fread (&kopf, sizeof (kopf), 1, file) != 1
+      || !joelix_kopf_pruefen (&kopf, joelix_kennung_checkpoint)
+      || kopf.laenge != (uint64_t) nvek || kopf.anzahl != (uint64_t) nskalare) {
+    fclose (file);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  laengen = malloc ((nvek > 0 ? nvek : 1) * sizeof (*laengen));
+  s = malloc ((nskalare > 0 ? nskalare : 1) * sizeof (*s));
+  if (laengen == NULL || s == NULL) {
+    free (laengen);
+    free (s);
+    fclose (file);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  ok = fread (laengen, sizeof (*laengen), nvek, file) == (size_t) nvek
+    && fread (s, sizeof (*s), nskalare, file) == (size_t) nskalare;
+  for (i = 0;i < nvek && ok;i++) {
+    ok = laengen[i] == (uint64_t) vektoren[i]->laenge;
+  }
+  h = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, laengen, nvek);
+  h = joelix_pruefsumme (h, s, nskalare);
+  for (i = 0;i < nvek && ok;i++) {
+    ok = fread (vektoren[i]->werte, sizeof (double), vektoren[i]->laenge, file)
+      == (size_t) vektoren[i]->laenge;
+    if (ok) h = joelix_pruefsumme (h, vektoren[i]->werte, vektoren[i]->laenge);
+  }
+  fclose (file);
+  if (ok && h == kopf.pruefsumme) {
+    if (nskalare > 0) memcpy (skalare, s, nskalare * sizeof (*s));
+    *iteration = (long) kopf.iteration;
+  } else {
+    ok = 0;
+  }
+  free (laengen);
+  free (s);
+  if (!ok) return (joelix_fehler_code = F_DATEI_FORMAT);
+  return (joelix_fehler_code = F_ERFOLG);
+}
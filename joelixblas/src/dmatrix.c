@@ -0,0 +1,642 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+/* Fuer pread, posix_fadvise und clock_gettime */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "operator.h"
+#include "datei_hidden.h"
+#include "datei.h"
+#include "dmatrix_hidden.h"
+#include "dmatrix.h"
+
+extern Joelix_Fehler joelix_fehler_code;
+
+static const char joelix_kennung_matrix[8] = {'J', 'O', 'E', 'L', 'I', 'X', 'M', '\n'};
+
+/* Anzahl der Worte der Blocktabelle pro Block */
+#define JOELIX_DMATRIX_TABELLE_WORTE 5
+
+/* Die Groesse eines Blocks in Byte: die Werte, dann Spaltenindices und
+   Zeilenanfaenge, aufgefuellt auf ganze Worte */
+static size_t joelix_dmatrix_block_bytes (uint64_t zeilen, uint64_t nnE)
+{
+  return nnE * sizeof (double) + ((nnE + zeilen + 1) * sizeof (int) + 7) / 8 * 8;
+}
+
+static double joelix_dmatrix_zeit (void)
+{
+  struct timespec t;
+
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Schreiben */
+
+static void joelix_dmatrix_schreiber_befreien (Joelix_dMatrix_Schreiber S)
+{
+  if (S->datei != NULL) fclose (S->datei);
+  free (S->zeilen_akk);
+  free (S->spalten);
+  free (S->werte);
+  free (S->tabelle);
+  free (S);
+}
+
+Joelix_Fehler joelix_dmatrix_schreiber_init (Joelix_dMatrix_Schreiber *pSchreiber,
+                                             const char *dateiname, int nzeilen, int nspalten,
+                                             int zeilen_pro_block)
+{
+  Joelix_dMatrix_Schreiber S;
+  struct joelix_datei_kopf kopf;
+
+  if (pSchreiber == NULL || dateiname == NULL || nzeilen < 0 || nspalten < 0
+      || zeilen_pro_block < 1) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  /* Ein Block hat nie mehr Zeilen als die Matrix. Das haelt auch
+     zeilen_pro_block + 1 im Wertebereich von int. */
+  if (zeilen_pro_block > nzeilen) zeilen_pro_block = nzeilen > 1 ? nzeilen : 1;
+  S = calloc (1, sizeof (*S));
+  if (S == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  S->n = nzeilen;
+  S->m = nspalten;
+  S->zeilen_pro_block = zeilen_pro_block;
+  S->block_kapazitaet = 1024;
+  S->tabelle_kapazitaet = 16;
+  S->zeilen_akk = malloc ((zeilen_pro_block + 1) * sizeof (*S->zeilen_akk));
+  S->spalten = malloc (S->block_kapazitaet * sizeof (*S->spalten));
+  S->werte = malloc (S->block_kapazitaet * sizeof (*S->werte));
+  S->tabelle = malloc (S->tabelle_kapazitaet * sizeof (*S->tabelle));
+  if (S->zeilen_akk == NULL || S->spalten == NULL || S->werte == NULL || S->tabelle == NULL) {
+    joelix_dmatrix_schreiber_befreien (S);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  S->zeilen_akk[0] = 0;
+  S->fehler = F_ERFOLG;
+  S->datei = fopen (dateiname, "wb");
+  if (S->datei == NULL) {
+    joelix_dmatrix_schreiber_befreien (S);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  /* Der Kopf wird am Ende geschrieben, bis dahin steht hier nur Platz */
+  memset (&kopf, 0, sizeof (kopf));
+  if (fwrite (&kopf, sizeof (kopf), 1, S->datei) != 1) {
+    joelix_dmatrix_schreiber_befreien (S);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  S->stelle = sizeof (kopf);
+  *pSchreiber = S;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Schreibt den aktuellen Block und beginnt den naechsten. Zeilen, die nicht
+   uebergeben wurden, sind Nullzeilen. */
+static Joelix_Fehler joelix_dmatrix_block_schreiben (Joelix_dMatrix_Schreiber S)
+{
+  struct joelix_dmatrix_block *b, *tabelle;
+  int zeilen, r;
+  size_t bytes, rest;
+  double *ausgabe;
+  char *p;
+
+  zeilen = S->n - S->block_anfang < S->zeilen_pro_block ? S->n - S->block_anfang
+                                                        : S->zeilen_pro_block;
+  for (r = S->naechste_zeile - S->block_anfang + 1;r <= zeilen;r++) {
+    S->zeilen_akk[r] = S->block_nnE;
+  }
+  if (S->nblock == S->tabelle_kapazitaet) {
+    tabelle = realloc (S->tabelle, 2 * S->tabelle_kapazitaet * sizeof (*tabelle));
+    if (tabelle == NULL) return (S->fehler = F_KEIN_SPEICHER);
+    S->tabelle = tabelle;
+    S->tabelle_kapazitaet *= 2;
+  }
+  /* Den Block zusammenhaengend aufbauen, damit die Pruefsumme ueber ganze
+     Worte laeuft */
+  bytes = joelix_dmatrix_block_bytes (zeilen, S->block_nnE);
+  ausgabe = malloc (bytes);
+  if (ausgabe == NULL) return (S->fehler = F_KEIN_SPEICHER);
+  p = (char *) ausgabe;
+  memcpy (p, S->werte, S->block_nnE * sizeof (double));
+  p += S->block_nnE * sizeof (double);
+  memcpy (p, S->spalten, S->block_nnE * sizeof (int));
+  p += S->block_nnE * sizeof (int);
+  memcpy (p, S->zeilen_akk, (zeilen + 1) * sizeof (int));
+  p += (zeilen + 1) * sizeof (int);
+  rest = bytes - (p - (char *) ausgabe);
+  memset (p, 0, rest);
+
+  b = S->tabelle + S->nblock;
+  b->erste_zeile = S->block_anfang;
+  b->zeilen = zeilen;
+  b->nnE = S->block_nnE;
+  b->stelle = S->stelle;
+  b->pruefsumme = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, ausgabe, bytes / 8);
+  if (fwrite (ausgabe, 1, bytes, S->datei) != bytes) S->fehler = F_FILEIO_FEHLER;
+  free (ausgabe);
+  if (S->fehler != F_ERFOLG) return S->fehler;
+  S->nblock++;
+  S->stelle += bytes;
+  S->nnE += S->block_nnE;
+  S->block_anfang += zeilen;
+  S->naechste_zeile = S->block_anfang;
+  S->block_nnE = 0;
+  return F_ERFOLG;
+}
+
+/* Eine Zeile anhaengen */
+Joelix_Fehler joelix_dmatrix_schreiber_zeile (Joelix_dMatrix_Schreiber S, int zeile,
+                                              int znichtnull, const double *werte,
+                                              const int *spalten)
+{
+  int j, r, kapazitaet, *neue_spalten;
+  double *neue_werte;
+
+  if (S == NULL || znichtnull < 0 || (znichtnull > 0 && (werte == NULL || spalten == NULL))) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (S->fehler != F_ERFOLG) return (joelix_fehler_code = S->fehler);
+  if (zeile < S->naechste_zeile || zeile >= S->n) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  for (j = 0;j < znichtnull;j++) {
+    if (spalten[j] < 0 || spalten[j] >= S->m) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  }
+  /* Fertige Bloecke schreiben */
+  while (zeile >= S->block_anfang + S->zeilen_pro_block) {
+    if (joelix_dmatrix_block_schreiben (S) != F_ERFOLG) return (joelix_fehler_code = S->fehler);
+  }
+  if (S->block_nnE + znichtnull > S->block_kapazitaet) {
+    kapazitaet = S->block_kapazitaet;
+    while (S->block_nnE + znichtnull > kapazitaet) kapazitaet *= 2;
+    neue_spalten = realloc (S->spalten, kapazitaet * sizeof (*neue_spalten));
+    if (neue_spalten == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+    S->spalten = neue_spalten;
+    neue_werte = realloc (S->werte, kapazitaet * sizeof (*neue_werte));
+    if (neue_werte == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+    S->werte = neue_werte;
+    S->block_kapazitaet = kapazitaet;
+  }
+  /* Die uebersprungenen Zeilen sind Nullzeilen */
+  for (r = S->naechste_zeile - S->block_anfang + 1;r <= zeile - S->block_anfang;r++) {
+    S->zeilen_akk[r] = S->block_nnE;
+  }
+  if (znichtnull > 0) {
+    memcpy (S->werte + S->block_nnE, werte, znichtnull * sizeof (*werte));
+    memcpy (S->spalten + S->block_nnE, spalten, znichtnull * sizeof (*spalten));
+  }
+  S->block_nnE += znichtnull;
+  S->zeilen_akk[zeile - S->block_anfang + 1] = S->block_nnE;
+  S->naechste_zeile = zeile + 1;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Restliche Bloecke, Tabelle und Kopf schreiben */
+Joelix_Fehler joelix_dmatrix_schreiber_beenden (Joelix_dMatrix_Schreiber *pSchreiber)
+{
+  Joelix_dMatrix_Schreiber S;
+  struct joelix_datei_kopf kopf;
+  Joelix_Fehler fehler;
+
+  if (pSchreiber == NULL || *pSchreiber == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  S = *pSchreiber;
+  while (S->fehler == F_ERFOLG && S->block_anfang < S->n) joelix_dmatrix_block_schreiben (S);
+  if (S->fehler == F_ERFOLG) {
+    joelix_kopf_init (&kopf, joelix_kennung_matrix);
+    kopf.laenge = S->n;
+    kopf.anzahl = S->m;
+    kopf.reserviert[0] = S->nnE;
+    kopf.reserviert[1] = S->nblock;
+    kopf.pruefsumme = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, S->tabelle,
+                                         (size_t) S->nblock * JOELIX_DMATRIX_TABELLE_WORTE);
+    if (fwrite (S->tabelle, sizeof (*S->tabelle), S->nblock, S->datei) != (size_t) S->nblock
+        || fseek (S->datei, 0, SEEK_SET) != 0
+        || fwrite (&kopf, sizeof (kopf), 1, S->datei) != 1) {
+      S->fehler = F_FILEIO_FEHLER;
+    }
+  }
+  if (fclose (S->datei) != 0 && S->fehler == F_ERFOLG) S->fehler = F_FILEIO_FEHLER;
+  S->datei = NULL;
+  fehler = S->fehler;
+  joelix_dmatrix_schreiber_befreien (S);
+  *pSchreiber = NULL;
+  return (joelix_fehler_code = fehler);
+}
+
+/* Eine gespeicherte Matrix schreiben */
+Joelix_Fehler joelix_dmatrix_schreiben (const char *dateiname, Joelix_sMatrix M,
+                                        int zeilen_pro_block)
+{
+  Joelix_dMatrix_Schreiber S;
+  Joelix_Fehler fehler;
+  int i, anfang;
+
+  if (dateiname == NULL || M == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  if (joelix_dmatrix_schreiber_init (&S, dateiname, M->n, M->m, zeilen_pro_block) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  for (i = 0;i < M->n && M->nnE > 0;i++) {
+    anfang = M->zeilen_akk[i];
+    if (M->zeilen_akk[i+1] == anfang) continue;
+    if (joelix_dmatrix_schreiber_zeile (S, i, M->zeilen_akk[i+1] - anfang, M->werte + anfang,
+                                        M->spalten_ind + anfang) != F_ERFOLG) {
+      /* Damit beenden nichts mehr schreibt und den Fehler zurueckgibt */
+      S->fehler = joelix_fehler_code;
+      break;
+    }
+  }
+  fehler = joelix_dmatrix_schreiber_beenden (&S);
+  /* Eine unvollstaendige Datei nicht liegen lassen */
+  if (fehler != F_ERFOLG) remove (dateiname);
+  return (joelix_fehler_code = fehler);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Lesen */
+
+/* Liest bytes Byte ab stelle, auch wenn pread weniger auf einmal liefert */
+static int joelix_dmatrix_lesen (int datei, void *puffer, size_t bytes, uint64_t stelle)
+{
+  char *p = puffer;
+  ssize_t r;
+
+  while (bytes > 0) {
+    r = pread (datei, p, bytes, (off_t) stelle);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return 0;
+    p += r;
+    bytes -= r;
+    stelle += r;
+  }
+  return 1;
+}
+
+static void joelix_dmatrix_befreien (Joelix_dMatrix A)
+{
+  if (A->datei >= 0) close (A->datei);
+  free (A->tabelle);
+  free (A->puffer[0]);
+  free (A->puffer[1]);
+  free (A);
+}
+
+Joelix_Fehler joelix_dmatrix_oeffnen (Joelix_dMatrix *pMatrix, const char *dateiname,
+                                      int flags)
+{
+  Joelix_dMatrix A;
+  struct joelix_datei_kopf kopf;
+  struct stat info;
+  uint64_t tabelle_stelle, zeile, nnE;
+  size_t bytes;
+  int k;
+
+  if (pMatrix == NULL || dateiname == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  A = calloc (1, sizeof (*A));
+  if (A == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  A->datei = open (dateiname, O_RDONLY);
+  if (A->datei < 0) {
+    free (A);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  if (fstat (A->datei, &info) != 0) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  /* Kopf pruefen. Die Tabelle steht am Ende der Datei. */
+  if (!joelix_dmatrix_lesen (A->datei, &kopf, sizeof (kopf), 0)
+      || !joelix_kopf_pruefen (&kopf, joelix_kennung_matrix)
+      || kopf.laenge > 2147483647u || kopf.anzahl > 2147483647u
+      || kopf.reserviert[1] > (uint64_t) info.st_size / sizeof (*A->tabelle)) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  A->n = (int) kopf.laenge;
+  A->m = (int) kopf.anzahl;
+  A->nnE = (long) kopf.reserviert[0];
+  A->nblock = (int) kopf.reserviert[1];
+  A->pruefen = !(flags & JOELIX_DATEI_UNGEPRUEFT);
+  tabelle_stelle = (uint64_t) info.st_size - (uint64_t) A->nblock * sizeof (*A->tabelle);
+  A->tabelle = malloc ((A->nblock > 0 ? A->nblock : 1) * sizeof (*A->tabelle));
+  if (A->tabelle == NULL) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  if (!joelix_dmatrix_lesen (A->datei, A->tabelle, A->nblock * sizeof (*A->tabelle),
+                             tabelle_stelle)
+      || joelix_pruefsumme (JOELIX_PRUEFSUMME_START, A->tabelle,
+                            (size_t) A->nblock * JOELIX_DMATRIX_TABELLE_WORTE) != kopf.pruefsumme) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  /* Die Bloecke muessen lueckenlos alle Zeilen und Eintraege ueberdecken
+     und vor der Tabelle liegen */
+  zeile = 0;
+  nnE = 0;
+  A->max_bytes = 8;
+  for (k = 0;k < A->nblock;k++) {
+    bytes = joelix_dmatrix_block_bytes (A->tabelle[k].zeilen, A->tabelle[k].nnE);
+    if (A->tabelle[k].erste_zeile != zeile || A->tabelle[k].nnE > 2147483647u
+        || A->tabelle[k].stelle < sizeof (kopf) || A->tabelle[k].stelle > tabelle_stelle
+        || bytes > tabelle_stelle - A->tabelle[k].stelle) {
+      joelix_dmatrix_befreien (A);
+      return (joelix_fehler_code = F_DATEI_FORMAT);
+    }
+    zeile += A->tabelle[k].zeilen;
+    nnE += A->tabelle[k].nnE;
+    if (bytes > A->max_bytes) A->max_bytes = bytes;
+  }
+  if (zeile != (uint64_t) A->n || nnE != (uint64_t) A->nnE) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_DATEI_FORMAT);
+  }
+  A->puffer[0] = malloc (A->max_bytes);
+  A->puffer[1] = malloc (A->max_bytes);
+  if (A->puffer[0] == NULL || A->puffer[1] == NULL) {
+    joelix_dmatrix_befreien (A);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  /* Die Datei wird immer von vorne nach hinten gelesen */
+  posix_fadvise (A->datei, 0, 0, POSIX_FADV_SEQUENTIAL);
+  *pMatrix = A;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+int joelix_dmatrix_zeilen (Joelix_dMatrix A)
+{
+  if (A == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return A->n;
+}
+
+int joelix_dmatrix_spalten (Joelix_dMatrix A)
+{
+  if (A == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return A->m;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Das Produkt. Der Lesethread fuellt abwechselnd die beiden Puffer, die
+   Rechnung gibt einen Puffer wieder frei, sobald der Block darin fertig
+   ist. */
+
+struct joelix_dmatrix_lauf
+{
+  Joelix_dMatrix A;
+  pthread_mutex_t mutex;
+  pthread_cond_t bedingung;
+  int geladen[2];       /* Der Block in Puffer 0 und 1, oder -1 wenn frei */
+  int abbruch;          /* Wird bei einem Lesefehler gesetzt */
+  Joelix_Fehler fehler;
+  double lese_zeit;     /* Nur vom Lesethread geschrieben */
+  double bytes;
+  long bloecke;
+};
+
+/* Prueft den Inhalt eines geladenen Blocks, damit die Rechnung auch bei
+   einer ungeprueften oder passend beschaedigten Datei nicht ausserhalb von
+   Puffer und Vektoren liest. Gibt 1 zurueck, wenn der Block stimmt. */
+static int joelix_dmatrix_block_pruefen (const struct joelix_dmatrix_block *b,
+                                         const double *puffer, int m)
+{
+  const int *spalten = (const int *) (puffer + b->nnE);
+  const int *zeilen_akk = spalten + b->nnE;
+  int r, k;
+
+  if (zeilen_akk[0] != 0 || zeilen_akk[b->zeilen] != (int) b->nnE) return 0;
+  for (r = 0;r < (int) b->zeilen;r++) {
+    if (zeilen_akk[r+1] < zeilen_akk[r]) return 0;
+  }
+  for (k = 0;k < (int) b->nnE;k++) {
+    if (spalten[k] < 0 || spalten[k] >= m) return 0;
+  }
+  return 1;
+}
+
+static void *joelix_dmatrix_leser (void *daten)
+{
+  struct joelix_dmatrix_lauf *l = daten;
+  Joelix_dMatrix A = l->A;
+  struct joelix_dmatrix_block *b;
+  size_t bytes;
+  double t;
+  int k, platz, ok;
+
+  for (k = 0;k < A->nblock;k++) {
+    platz = k & 1;
+    pthread_mutex_lock (&l->mutex);
+    while (l->geladen[platz] >= 0 && !l->abbruch) pthread_cond_wait (&l->bedingung, &l->mutex);
+    ok = !l->abbruch;
+    pthread_mutex_unlock (&l->mutex);
+    if (!ok) break;
+
+    b = A->tabelle + k;
+    bytes = joelix_dmatrix_block_bytes (b->zeilen, b->nnE);
+    t = joelix_dmatrix_zeit ();
+    ok = joelix_dmatrix_lesen (A->datei, A->puffer[platz], bytes, b->stelle);
+    l->lese_zeit += joelix_dmatrix_zeit () - t;
+    l->bytes += bytes;
+    l->bloecke++;
+    if (ok && A->pruefen) {
+      ok = joelix_pruefsumme (JOELIX_PRUEFSUMME_START, A->puffer[platz], bytes / 8)
+           == b->pruefsumme;
+      if (!ok) l->fehler = F_DATEI_FORMAT;
+    }
+    else if (!ok) {
+      l->fehler = F_FILEIO_FEHLER;
+    }
+    if (ok && !joelix_dmatrix_block_pruefen (b, A->puffer[platz], A->m)) {
+      ok = 0;
+      l->fehler = F_DATEI_FORMAT;
+    }
+
+    pthread_mutex_lock (&l->mutex);
+    if (ok) l->geladen[platz] = k;
+    else l->abbruch = 1;
+    pthread_cond_broadcast (&l->bedingung);
+    pthread_mutex_unlock (&l->mutex);
+    if (!ok) break;
+  }
+  return NULL;
+}
+
+/* Die Zeilen eines Blocks von Y = AX */
+static void joelix_dmatrix_block_rechnen (const struct joelix_dmatrix_block *b,
+                                          const double *puffer, double *Y, const double *X,
+                                          int nvek)
+{
+  const double *werte = puffer, *x;
+  const int *spalten = (const int *) (puffer + b->nnE);
+  const int *zeilen_akk = spalten + b->nnE;
+  int r, k, v;
+  double summe, wert, *y;
+
+  if (nvek == 1) {
+    for (r = 0;r < (int) b->zeilen;r++) {
+      summe = 0;
+      for (k = zeilen_akk[r];k < zeilen_akk[r+1];k++) summe += werte[k] * X[spalten[k]];
+      Y[b->erste_zeile + r] = summe;
+    }
+    return;
+  }
+  for (r = 0;r < (int) b->zeilen;r++) {
+    y = Y + (long) (b->erste_zeile + r) * nvek;
+    for (v = 0;v < nvek;v++) y[v] = 0;
+    for (k = zeilen_akk[r];k < zeilen_akk[r+1];k++) {
+      wert = werte[k];
+      x = X + (long) spalten[k] * nvek;
+      for (v = 0;v < nvek;v++) y[v] += wert * x[v];
+    }
+  }
+}
+
+/* Y = AX fuer nvek zeilenweise gespeicherte Vektoren, ein Durchlauf durch
+   die Datei */
+static Joelix_Fehler joelix_dmatrix_anwenden (Joelix_dMatrix A, double *Y, const double *X,
+                                              int nvek)
+{
+  struct joelix_dmatrix_lauf l;
+  pthread_t leser;
+  double t, warten = 0, rechnen = 0;
+  int k, platz, ok = 1;
+
+  if (A->nblock == 0) return F_ERFOLG;
+  l.A = A;
+  l.geladen[0] = l.geladen[1] = -1;
+  l.abbruch = 0;
+  l.fehler = F_ERFOLG;
+  l.lese_zeit = 0;
+  l.bytes = 0;
+  l.bloecke = 0;
+  if (pthread_mutex_init (&l.mutex, NULL) != 0) return F_THREAD_FEHLER;
+  if (pthread_cond_init (&l.bedingung, NULL) != 0) {
+    pthread_mutex_destroy (&l.mutex);
+    return F_THREAD_FEHLER;
+  }
+  if (pthread_create (&leser, NULL, joelix_dmatrix_leser, &l) != 0) {
+    pthread_cond_destroy (&l.bedingung);
+    pthread_mutex_destroy (&l.mutex);
+    return F_THREAD_FEHLER;
+  }
+  for (k = 0;k < A->nblock && ok;k++) {
+    platz = k & 1;
+    t = joelix_dmatrix_zeit ();
+    pthread_mutex_lock (&l.mutex);
+    while (l.geladen[platz] != k && !l.abbruch) pthread_cond_wait (&l.bedingung, &l.mutex);
+    ok = l.geladen[platz] == k;
+    pthread_mutex_unlock (&l.mutex);
+    warten += joelix_dmatrix_zeit () - t;
+    if (!ok) break;
+
+    t = joelix_dmatrix_zeit ();
+    joelix_dmatrix_block_rechnen (A->tabelle + k, A->puffer[platz], Y, X, nvek);
+    rechnen += joelix_dmatrix_zeit () - t;
+
+    pthread_mutex_lock (&l.mutex);
+    l.geladen[platz] = -1;
+    pthread_cond_broadcast (&l.bedingung);
+    pthread_mutex_unlock (&l.mutex);
+  }
+  pthread_join (leser, NULL);
+  pthread_cond_destroy (&l.bedingung);
+  pthread_mutex_destroy (&l.mutex);
+
+  A->statistik.produkte++;
+  A->statistik.bloecke += l.bloecke;
+  A->statistik.bytes += l.bytes;
+  A->statistik.lese_zeit += l.lese_zeit;
+  A->statistik.warte_zeit += warten;
+  A->statistik.rechen_zeit += rechnen;
+  return l.fehler;
+}
+
+/* b = Ax */
+Joelix_Fehler joelix_dmatrix_smatvec (Joelix_Vektor b, Joelix_dMatrix A, Joelix_Vektor x)
+{
+  if (b == NULL || A == NULL || x == NULL || b == x) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (b->laenge != A->n || x->laenge != A->m) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  return (joelix_fehler_code = joelix_dmatrix_anwenden (A, b->werte, x->werte, 1));
+}
+
+static Joelix_Fehler joelix_dmatrix_operator_anwenden (double *y, const double *x, void *daten)
+{
+  return joelix_dmatrix_anwenden (daten, y, x, 1);
+}
+
+static Joelix_Fehler joelix_dmatrix_operator_mehrfach (double *Y, const double *X, int nvek,
+                                                       void *daten)
+{
+  return joelix_dmatrix_anwenden (daten, Y, X, nvek);
+}
+
+Joelix_Fehler joelix_dmatrix_operator (Joelix_Operator *pOperator, Joelix_dMatrix A)
+{
+  if (pOperator == NULL || A == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  return joelix_operator_init (pOperator, A->n, A->m, joelix_dmatrix_operator_anwenden,
+                               joelix_dmatrix_operator_mehrfach, A);
+}
+
+Joelix_Fehler joelix_dmatrix_statistik (Joelix_dMatrix A, Joelix_dMatrix_Statistik *statistik)
+{
+  if (A == NULL || statistik == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  *statistik = A->statistik;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_dmatrix_statistik_zuruecksetzen (Joelix_dMatrix A)
+{
+  if (A == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  memset (&A->statistik, 0, sizeof (A->statistik));
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_dmatrix_schliessen (Joelix_dMatrix *pMatrix)
+{
+  if (pMatrix == NULL || *pMatrix == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_dmatrix_befreien (*pMatrix);
+  *pMatrix = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
@@ -0,0 +1,577 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "operator_hidden.h"
+#include "operator.h"
+#include "eigen.h"
+
+/* Alle Bloecke von Vektoren werden zeilenweise gespeichert: Eintrag i von
+   Vektor v eines Blocks mit Zeilenlaenge ld steht an Stelle i*ld+v. Damit
+   laufen alle dichten Operationen mit einem Block in einem einzigen
+   Durchlauf ueber den Speicher. */
+
+/* Pseudozufallszahl in [-0.5, 0.5). Deterministisch, damit die Ergebnisse
+   reproduzierbar sind. */
+static double joelix_zufall (unsigned long *zustand)
+{
+  *zustand = (*zustand * 1103515245UL + 12345UL) & 0x7fffffffUL;
+  return *zustand / 2147483648.0 - 0.5;
+}
+
+/* G = A^T B fuer Bloecke A (n x na) und B (n x nb). G hat Zeilenlaenge ldg. */
+static void joelix_dicht_tmult (double *G, int ldg, const double *A, int lda, int na,
+                                const double *B, int ldb, int nb, int n)
+{
+  int i, a, b;
+  const double *ai, *bi;
+
+  for (a = 0;a < na;a++) {
+    for (b = 0;b < nb;b++) G[a * ldg + b] = 0;
+  }
+  for (i = 0;i < n;i++) {
+    ai = A + (long) i * lda;
+    bi = B + (long) i * ldb;
+    for (a = 0;a < na;a++) {
+      for (b = 0;b < nb;b++) G[a * ldg + b] += ai[a] * bi[b];
+    }
+  }
+}
+
+/* Out = alpha * In C + beta * Out fuer einen Block In (n x ni) und eine
+   dichte Matrix C (ni x no). Out und In duerfen nicht ueberlappen. */
+static void joelix_dicht_mult (double *Out, int ldo, int no, double alpha,
+                               const double *In, int ldi, int ni,
+                               const double *C, int ldc, double beta, int n)
+{
+  int i, c, o;
+  double *oi;
+  const double *ii;
+
+  for (i = 0;i < n;i++) {
+    oi = Out + (long) i * ldo;
+    ii = In + (long) i * ldi;
+    for (o = 0;o < no;o++) oi[o] = beta == 0 ? 0 : beta * oi[o];
+    for (c = 0;c < ni;c++) {
+      for (o = 0;o < no;o++) oi[o] += alpha * ii[c] * C[c * ldc + o];
+    }
+  }
+}
+
+/* B = B C fuer einen Block B (n x ni, Zeilenlaenge ldalt) und C (ni x no).
+   Das Ergebnis hat Zeilenlaenge ldneu <= ldalt. zeile ist ein Puffer der
+   Laenge ni. */
+static void joelix_dicht_mult_inplace (double *B, int ldalt, int ni, const double *C, int ldc,
+                                       int no, int ldneu, int n, double *zeile)
+{
+  int i, c, o;
+  double *bi;
+
+  for (i = 0;i < n;i++) {
+    memcpy (zeile, B + (long) i * ldalt, ni * sizeof (*zeile));
+    bi = B + (long) i * ldneu;
+    for (o = 0;o < no;o++) {
+      bi[o] = 0;
+      for (c = 0;c < ni;c++) bi[o] += zeile[c] * C[c * ldc + o];
+    }
+  }
+}
+
+/* Berechnet alle Eigenwerte und Eigenvektoren der symmetrischen m x m Matrix
+   A mit dem zyklischen Jacobi-Verfahren. A wird dabei zerstoert. Die
+   Eigenwerte stehen danach aufsteigend in lambda, Spalte j von Q (Zeilenlaenge
+   m) ist der Eigenvektor zu lambda[j]. */
+static void joelix_jacobi (double *A, int m, double *lambda, double *Q)
+{
+  int p, q, r, sweep, j, min;
+  double aus, gesamt, theta, t, c, s, apr, aqr, tmp;
+
+  for (p = 0;p < m;p++) {
+    for (q = 0;q < m;q++) Q[p * m + q] = (p == q);
+  }
+  for (sweep = 0;sweep < 100;sweep++) {
+    aus = gesamt = 0;
+    for (p = 0;p < m;p++) {
+      for (q = 0;q < m;q++) {
+        gesamt += A[p * m + q] * A[p * m + q];
+        if (p != q) aus += A[p * m + q] * A[p * m + q];
+      }
+    }
+    if (aus <= 1e-30 * gesamt || aus == 0) break;
+    for (p = 0;p < m - 1;p++) {
+      for (q = p + 1;q < m;q++) {
+        if (A[p * m + q] == 0) continue;
+        /* Rotation, die A[p][q] zu null macht */
+        theta = (A[q * m + q] - A[p * m + p]) / (2 * A[p * m + q]);
+        t = (theta >= 0 ? 1.0 : -1.0) / (fabs (theta) + sqrt (theta * theta + 1));
+        c = 1 / sqrt (t * t + 1);
+        s = t * c;
+        for (r = 0;r < m;r++) {
+          apr = A[r * m + p];
+          aqr = A[r * m + q];
+          A[r * m + p] = c * apr - s * aqr;
+          A[r * m + q] = s * apr + c * aqr;
+        }
+        for (r = 0;r < m;r++) {
+          apr = A[p * m + r];
+          aqr = A[q * m + r];
+          A[p * m + r] = c * apr - s * aqr;
+          A[q * m + r] = s * apr + c * aqr;
+        }
+        for (r = 0;r < m;r++) {
+          apr = Q[r * m + p];
+          aqr = Q[r * m + q];
+          Q[r * m + p] = c * apr - s * aqr;
+          Q[r * m + q] = s * apr + c * aqr;
+        }
+      }
+    }
+  }
+  for (p = 0;p < m;p++) lambda[p] = A[p * m + p];
+  /* Aufsteigend sortieren */
+  for (j = 0;j < m - 1;j++) {
+    min = j;
+    for (p = j + 1;p < m;p++) {
+      if (lambda[p] < lambda[min]) min = p;
+    }
+    if (min != j) {
+      tmp = lambda[j];
+      lambda[j] = lambda[min];
+      lambda[min] = tmp;
+      for (r = 0;r < m;r++) {
+        tmp = Q[r * m + j];
+        Q[r * m + j] = Q[r * m + min];
+        Q[r * m + min] = tmp;
+      }
+    }
+  }
+}
+
+/* Orthonormalisiert die Spalten von B (n x ncol) mit der SVQB-Methode:
+   Aus der Gram-Matrix G = B^T B wird B := B D Q L^(-1/2) berechnet, wobei
+   D die Diagonale von G skaliert und D G D = Q L Q^T. Linear abhaengige
+   Spalten (sehr kleine Eigenwerte) werden weggelassen. Gibt die Anzahl der
+   verbleibenden Spalten zurueck; B hat danach diese Zeilenlaenge.
+   puffer muss mindestens 3 ncol^2 + 2 ncol doubles haben. */
+static int joelix_svqb (double *B, int ncol, int n, double *puffer)
+{
+  double *G = puffer, *Q = G + ncol * ncol, *C = Q + ncol * ncol;
+  double *lambda = C + ncol * ncol, *d = lambda + ncol;
+  int a, b, erste, nneu;
+
+  if (ncol == 0) return 0;
+  joelix_dicht_tmult (G, ncol, B, ncol, ncol, B, ncol, ncol, n);
+  for (a = 0;a < ncol;a++) d[a] = G[a * ncol + a] > 0 ? 1 / sqrt (G[a * ncol + a]) : 0;
+  for (a = 0;a < ncol;a++) {
+    for (b = 0;b < ncol;b++) G[a * ncol + b] *= d[a] * d[b];
+  }
+  joelix_jacobi (G, ncol, lambda, Q);
+  /* Die Eigenwerte sind aufsteigend, wir behalten die grossen */
+  for (erste = 0;erste < ncol && lambda[erste] <= 1e-12 * lambda[ncol-1];erste++);
+  nneu = ncol - erste;
+  for (a = 0;a < ncol;a++) {
+    for (b = 0;b < nneu;b++) {
+      C[a * nneu + b] = d[a] * Q[a * ncol + erste + b] / sqrt (lambda[erste + b]);
+    }
+  }
+  joelix_dicht_mult_inplace (B, ncol, ncol, C, nneu, nneu, nneu, n, d);
+  return nneu;
+}
+
+/* B := B - X (X^T B) fuer einen Block X mit orthonormalen Spalten.
+   H ist ein Puffer der Groesse nx * nb. */
+static void joelix_block_projizieren (double *B, int nb, const double *X, int nx, int n,
+                                      double *H)
+{
+  if (nb == 0 || nx == 0) return;
+  joelix_dicht_tmult (H, nb, X, nx, nx, B, nb, nb, n);
+  joelix_dicht_mult (B, nb, nb, -1.0, X, nx, nx, H, nb, 1.0, n);
+}
+
+/* Thick-restart Lanczos */
+Joelix_Fehler joelix_eigen_lanczos_op (Joelix_Operator A, int k, double tol, int maxiter,
+                                       double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                       int *iterationen)
+{
+  int n, m, ld, p, i, j, c, l, neustart, konvergiert, start;
+  double *V = NULL, *T = NULL, *S = NULL, *Y = NULL, *theta = NULL, *h = NULL, *zeile = NULL;
+  double *w, beta, beta_letzt = 0, norm, skala;
+  Joelix_Vektor q = NULL, r = NULL;
+  unsigned long zustand = 4711;
+  Joelix_Fehler fehler = F_ERFOLG;
+
+  if (A == NULL || eigenwerte == NULL || eigenvektoren == NULL || tol <= 0 || maxiter < 1) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (A->n != A->m) return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_NICHT_QUADRATISCH);
+  n = A->n;
+  if (k < 1 || k > n) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  for (c = 0;c < k;c++) {
+    if (eigenvektoren[c] == NULL || eigenvektoren[c]->laenge != n) {
+      return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+    }
+  }
+
+  /* Basisgroesse m, die Basis hat m+1 Spalten (die letzte ist der
+     Residuenvektor) */
+  m = 2 * k > k + 20 ? 2 * k : k + 20;
+  if (m > n) m = n;
+  ld = m + 1;
+  V = malloc ((long) n * ld * sizeof (*V));
+  T = malloc (m * m * sizeof (*T));
+  S = malloc (m * m * sizeof (*S));
+  Y = malloc (m * m * sizeof (*Y));
+  theta = malloc (m * sizeof (*theta));
+  h = malloc (ld * sizeof (*h));
+  zeile = malloc (ld * sizeof (*zeile));
+  if (V == NULL || T == NULL || S == NULL || Y == NULL || theta == NULL || h == NULL || zeile == NULL
+      || joelix_vektor_init (&q, n) != F_ERFOLG || joelix_vektor_init (&r, n) != F_ERFOLG) {
+    fehler = F_KEIN_SPEICHER;
+    goto aufraeumen;
+  }
+
+  /* Startvektor */
+  norm = 0;
+  for (i = 0;i < n;i++) norm += eigenvektoren[0]->werte[i] * eigenvektoren[0]->werte[i];
+  for (i = 0;i < n;i++) {
+    V[(long) i * ld] = norm > 0 ? eigenvektoren[0]->werte[i] : joelix_zufall (&zustand);
+  }
+  norm = 0;
+  for (i = 0;i < n;i++) norm += V[(long) i * ld] * V[(long) i * ld];
+  norm = sqrt (norm);
+  for (i = 0;i < n;i++) V[(long) i * ld] /= norm;
+
+  memset (T, 0, m * m * sizeof (*T));
+  start = 0;
+  for (neustart = 0;;neustart++) {
+    /* Lanczos-Schritte start, ..., m-1 */
+    for (j = start;j < m;j++) {
+      for (i = 0;i < n;i++) q->werte[i] = V[(long) i * ld + j];
+      fehler = A->anwenden (r->werte, q->werte, A->daten);
+      if (fehler != F_ERFOLG) goto aufraeumen;
+      w = r->werte;
+      /* Vollstaendige Reorthogonalisierung gegen die Spalten 0..j,
+         zweimal klassisches Gram-Schmidt */
+      joelix_dicht_tmult (h, 1, V, ld, j + 1, w, 1, 1, n);
+      joelix_dicht_mult (w, 1, 1, -1.0, V, ld, j + 1, h, 1, 1.0, n);
+      for (c = 0;c <= j;c++) T[c * m + j] = T[j * m + c] = h[c];
+      joelix_dicht_tmult (h, 1, V, ld, j + 1, w, 1, 1, n);
+      joelix_dicht_mult (w, 1, 1, -1.0, V, ld, j + 1, h, 1, 1.0, n);
+      for (c = 0;c <= j;c++) {
+        T[c * m + j] += h[c];
+        if (c != j) T[j * m + c] = T[c * m + j];
+      }
+      beta = 0;
+      for (i = 0;i < n;i++) beta += w[i] * w[i];
+      beta = sqrt (beta);
+      skala = fabs (T[j * m + j]) + beta;
+      if (beta <= 1e-12 * skala) {
+        /* Invarianter Unterraum gefunden. Wir setzen mit einem zufaelligen
+           Vektor orthogonal zur Basis fort, die Kopplung ist dann 0. */
+        for (i = 0;i < n;i++) w[i] = joelix_zufall (&zustand);
+        for (l = 0;l < 2;l++) {
+          joelix_dicht_tmult (h, 1, V, ld, j + 1, w, 1, 1, n);
+          joelix_dicht_mult (w, 1, 1, -1.0, V, ld, j + 1, h, 1, 1.0, n);
+        }
+        norm = 0;
+        for (i = 0;i < n;i++) norm += w[i] * w[i];
+        norm = sqrt (norm);
+        for (i = 0;i < n;i++) V[(long) i * ld + j + 1] = norm > 0 ? w[i] / norm : 0;
+        beta = 0;
+      }
+      else {
+        for (i = 0;i < n;i++) V[(long) i * ld + j + 1] = w[i] / beta;
+      }
+      if (j + 1 < m) T[(j + 1) * m + j] = T[j * m + j + 1] = beta;
+      else beta_letzt = beta;
+    }
+
+    /* Ritzwerte und Residuen. joelix_jacobi zerstoert seine Eingabe, daher
+       rechnen wir auf einer Kopie von T. Das Residuum von Ritzpaar c ist
+       |beta_letzt * Y[m-1][c]|. */
+    memcpy (S, T, m * m * sizeof (*T));
+    joelix_jacobi (S, m, theta, Y);
+    skala = fabs (theta[0]) > fabs (theta[m-1]) ? fabs (theta[0]) : fabs (theta[m-1]);
+    konvergiert = 1;
+    for (c = 0;c < k;c++) {
+      if (fabs (beta_letzt * Y[(m - 1) * m + c])
+          > tol * (fabs (theta[c]) > 1e-14 * skala ? fabs (theta[c]) : 1e-14 * skala)) {
+        konvergiert = 0;
+      }
+    }
+    if (konvergiert || neustart + 1 >= maxiter || m == n) break;
+
+    /* Dicker Neustart: Behalte die p kleinsten Ritzvektoren und den
+       Residuenvektor. T hat danach Pfeilform: diag(theta) mit der
+       Kopplung beta_letzt * Y[m-1][c] zum Residuenvektor. */
+    p = k + (m - k) / 2;
+    if (p > m - 1) p = m - 1;
+    for (i = 0;i < n;i++) {
+      memcpy (zeile, V + (long) i * ld, m * sizeof (*zeile));
+      for (c = 0;c < p;c++) {
+        V[(long) i * ld + c] = 0;
+        for (l = 0;l < m;l++) V[(long) i * ld + c] += zeile[l] * Y[l * m + c];
+      }
+      V[(long) i * ld + p] = V[(long) i * ld + m];
+    }
+    memset (T, 0, m * m * sizeof (*T));
+    for (c = 0;c < p;c++) {
+      T[c * m + c] = theta[c];
+      T[c * m + p] = T[p * m + c] = beta_letzt * Y[(m - 1) * m + c];
+    }
+    start = p;
+  }
+
+  /* Ritzvektoren X = V Y(:, 0..k-1) */
+  for (c = 0;c < k;c++) eigenwerte[c] = theta[c];
+  for (i = 0;i < n;i++) {
+    for (c = 0;c < k;c++) {
+      eigenvektoren[c]->werte[i] = 0;
+      for (l = 0;l < m;l++) eigenvektoren[c]->werte[i] += V[(long) i * ld + l] * Y[l * m + c];
+    }
+  }
+  if (iterationen != NULL) *iterationen = neustart + 1;
+  if (!konvergiert && m < n) fehler = F_EIGEN_TERMINIERT_NICHT;
+
+aufraeumen:
+  free (V);
+  free (T);
+  free (S);
+  free (Y);
+  free (theta);
+  free (h);
+  free (zeile);
+  if (q != NULL) joelix_vektor_loeschen (&q);
+  if (r != NULL) joelix_vektor_loeschen (&r);
+  return (joelix_fehler_code = fehler);
+}
+
+/* Block-LOBPCG. X enthaelt die aktuellen Naeherungen, W die
+   (vorkonditionierten) Residuen und P die letzten Suchrichtungen, jeweils
+   mit den Produkten AX, AW, AP. In jedem Schritt wird ein Rayleigh-Ritz
+   Verfahren im Raum [X W P] durchgefuehrt. Damit dieses ein gewoehnliches
+   Eigenwertproblem ist, werden W und P vorher gegen X und gegeneinander
+   orthonormalisiert. */
+Joelix_Fehler joelix_eigen_lobpcg_op (Joelix_Operator A, int k, double tol, int maxiter,
+                                      Joelix_Vorkonditionierer T, void *daten,
+                                      double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                      int *iterationen)
+{
+  int n, i, c, l, s, nx, nw, np, iter, konvergiert, startwerte;
+  double *X = NULL, *AX = NULL, *W = NULL, *AW = NULL, *P = NULL, *AP = NULL, *Z = NULL;
+  double *G = NULL, *C = NULL, *lambda = NULL, *puffer = NULL, *tausch;
+  double norm, skala;
+  unsigned long zustand = 4711;
+  Joelix_Fehler fehler = F_ERFOLG;
+
+  if (A == NULL || eigenwerte == NULL || eigenvektoren == NULL || tol <= 0 || maxiter < 1) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (A->n != A->m) return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_NICHT_QUADRATISCH);
+  n = A->n;
+  if (k < 1 || k > n) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  for (c = 0;c < k;c++) {
+    if (eigenvektoren[c] == NULL || eigenvektoren[c]->laenge != n) {
+      return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+    }
+  }
+
+  X = malloc ((long) n * k * sizeof (*X));
+  AX = malloc ((long) n * k * sizeof (*AX));
+  W = malloc ((long) n * k * sizeof (*W));
+  AW = malloc ((long) n * k * sizeof (*AW));
+  P = malloc ((long) n * k * sizeof (*P));
+  AP = malloc ((long) n * k * sizeof (*AP));
+  Z = malloc ((long) n * k * sizeof (*Z));
+  G = malloc (9 * k * k * sizeof (*G));
+  C = malloc (9 * k * k * sizeof (*C));
+  lambda = malloc (3 * k * sizeof (*lambda));
+  puffer = malloc ((3 * k * k + 2 * k) * sizeof (*puffer));
+  if (X == NULL || AX == NULL || W == NULL || AW == NULL || P == NULL || AP == NULL
+      || Z == NULL || G == NULL || C == NULL || lambda == NULL || puffer == NULL) {
+    fehler = F_KEIN_SPEICHER;
+    goto aufraeumen;
+  }
+
+  /* Startwerte: die uebergebenen Vektoren, falls nicht alle null */
+  startwerte = 0;
+  for (c = 0;c < k;c++) {
+    for (i = 0;i < n;i++) {
+      X[(long) i * k + c] = eigenvektoren[c]->werte[i];
+      if (X[(long) i * k + c] != 0) startwerte = 1;
+    }
+  }
+  nx = startwerte ? joelix_svqb (X, k, n, puffer) : 0;
+  if (nx < k) {
+    /* Keine oder linear abhaengige Startwerte */
+    for (i = 0;i < (long) n * k;i++) X[i] = joelix_zufall (&zustand);
+    nx = joelix_svqb (X, k, n, puffer);
+    if (nx < k) {
+      fehler = F_FALSCHE_PARAMETER;
+      goto aufraeumen;
+    }
+  }
+
+  /* Rayleigh-Ritz im Raum X */
+  fehler = joelix_operator_mehrfach (AX, A, X, k);
+  if (fehler != F_ERFOLG) goto aufraeumen;
+  joelix_dicht_tmult (G, k, X, k, k, AX, k, k, n);
+  joelix_jacobi (G, k, lambda, C);
+  joelix_dicht_mult_inplace (X, k, k, C, k, k, k, n, puffer);
+  joelix_dicht_mult_inplace (AX, k, k, C, k, k, k, n, puffer);
+
+  np = 0;
+  konvergiert = 0;
+  for (iter = 0;iter < maxiter;iter++) {
+    /* Residuen W = AX - X diag(lambda) */
+    for (i = 0;i < n;i++) {
+      for (c = 0;c < k;c++) {
+        W[(long) i * k + c] = AX[(long) i * k + c] - lambda[c] * X[(long) i * k + c];
+      }
+    }
+    skala = fabs (lambda[0]) > fabs (lambda[k-1]) ? fabs (lambda[0]) : fabs (lambda[k-1]);
+    konvergiert = 1;
+    for (c = 0;c < k;c++) {
+      norm = 0;
+      for (i = 0;i < n;i++) norm += W[(long) i * k + c] * W[(long) i * k + c];
+      if (sqrt (norm) > tol * (fabs (lambda[c]) > 1e-14 * skala ? fabs (lambda[c]) : 1e-14 * skala)) {
+        konvergiert = 0;
+      }
+    }
+    if (konvergiert) break;
+
+    /* Vorkonditionieren */
+    if (T != NULL) {
+      fehler = T (Z, W, n, k, daten);
+      if (fehler != F_ERFOLG) goto aufraeumen;
+      tausch = W;
+      W = Z;
+      Z = tausch;
+    }
+
+    /* W orthogonal zu X und orthonormal machen */
+    joelix_block_projizieren (W, k, X, k, n, puffer);
+    joelix_block_projizieren (W, k, X, k, n, puffer);
+    nw = joelix_svqb (W, k, n, puffer);
+    /* P orthogonal zu X und W und orthonormal machen */
+    for (l = 0;l < 2;l++) {
+      joelix_block_projizieren (P, np, X, k, n, puffer);
+      joelix_block_projizieren (P, np, W, nw, n, puffer);
+    }
+    np = joelix_svqb (P, np, n, puffer);
+    /* Die Produkte mit A fuer alle neuen Richtungen auf einmal */
+    if (nw > 0) fehler = joelix_operator_mehrfach (AW, A, W, nw);
+    if (fehler == F_ERFOLG && np > 0) fehler = joelix_operator_mehrfach (AP, A, P, np);
+    if (fehler != F_ERFOLG) goto aufraeumen;
+
+    /* Rayleigh-Ritz im Raum [X W P] mit Dimension s */
+    s = k + nw + np;
+    joelix_dicht_tmult (G, s, X, k, k, AX, k, k, n);
+    joelix_dicht_tmult (G + k, s, X, k, k, AW, nw, nw, n);
+    joelix_dicht_tmult (G + k + nw, s, X, k, k, AP, np, np, n);
+    joelix_dicht_tmult (G + k * s + k, s, W, nw, nw, AW, nw, nw, n);
+    joelix_dicht_tmult (G + k * s + k + nw, s, W, nw, nw, AP, np, np, n);
+    joelix_dicht_tmult (G + (k + nw) * s + k + nw, s, P, np, np, AP, np, np, n);
+    for (c = 0;c < s;c++) {
+      for (l = 0;l < c;l++) G[c * s + l] = G[l * s + c];
+    }
+    joelix_jacobi (G, s, lambda, C);
+
+    /* Neue Naeherungen X = X Cx + W Cw + P Cp und neue Richtungen
+       P = W Cw + P Cp, wobei Cx, Cw, Cp die Zeilenbloecke der ersten k
+       Spalten von C sind */
+    joelix_dicht_mult (Z, k, k, 1.0, W, nw, nw, C + k * s, s, 0.0, n);
+    joelix_dicht_mult (Z, k, k, 1.0, P, np, np, C + (k + nw) * s, s, 1.0, n);
+    tausch = P;
+    P = Z;
+    Z = tausch;
+    joelix_dicht_mult (Z, k, k, 1.0, X, k, k, C, s, 0.0, n);
+    for (i = 0;i < (long) n * k;i++) Z[i] += P[i];
+    tausch = X;
+    X = Z;
+    Z = tausch;
+    joelix_dicht_mult (Z, k, k, 1.0, AX, k, k, C, s, 0.0, n);
+    joelix_dicht_mult (Z, k, k, 1.0, AW, nw, nw, C + k * s, s, 1.0, n);
+    joelix_dicht_mult (Z, k, k, 1.0, AP, np, np, C + (k + nw) * s, s, 1.0, n);
+    tausch = AX;
+    AX = Z;
+    Z = tausch;
+    np = k;
+  }
+
+  for (c = 0;c < k;c++) {
+    eigenwerte[c] = lambda[c];
+    for (i = 0;i < n;i++) eigenvektoren[c]->werte[i] = X[(long) i * k + c];
+  }
+  if (iterationen != NULL) *iterationen = iter;
+  if (!konvergiert) fehler = F_EIGEN_TERMINIERT_NICHT;
+
+aufraeumen:
+  free (X);
+  free (AX);
+  free (W);
+  free (AW);
+  free (P);
+  free (AP);
+  free (Z);
+  free (G);
+  free (C);
+  free (lambda);
+  free (puffer);
+  return (joelix_fehler_code = fehler);
+}
+
+/* Die Varianten fuer sparse Matrizen laufen ueber einen Operator auf dem
+   Stack, der die Matrix nur umhuellt. */
+Joelix_Fehler joelix_eigen_lanczos (Joelix_sMatrix A, int k, double tol, int maxiter,
+                                    double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                    int *iterationen)
+{
+  struct Joelix_Operator_t op;
+
+  if (A == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_operator_smatrix_setzen (&op, A);
+  return joelix_eigen_lanczos_op (&op, k, tol, maxiter, eigenwerte, eigenvektoren, iterationen);
+}
+
+Joelix_Fehler joelix_eigen_lobpcg (Joelix_sMatrix A, int k, double tol, int maxiter,
+                                   Joelix_Vorkonditionierer T, void *daten,
+                                   double *eigenwerte, Joelix_Vektor *eigenvektoren,
+                                   int *iterationen)
+{
+  struct Joelix_Operator_t op;
+
+  if (A == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_operator_smatrix_setzen (&op, A);
+  return joelix_eigen_lobpcg_op (&op, k, tol, maxiter, T, daten, eigenwerte, eigenvektoren,
+                                 iterationen);
+}
@@ -36,7 +36,13 @@ const char* joelix_fehler_beschreibung_hidden [] = {
     "Falsche Dimensionen: Matrix nicht quadratisch.",
     "Falsche Anzahl von nicht-Null Werten.",
     "Fehler beim schreiben oder lesen von Datei.",
-    "Das CG-Verfahren terminiert nicht."
+    "Das CG-Verfahren terminiert nicht.",
+    "Fehler beim Erzeugen der Threads.",
+    "Fehler bei der MPI Kommunikation.",
+    "Der Eigenwertloeser terminiert nicht.",
+    "Die Datei hat ein falsches Format oder ist beschaedigt.",
+    "Die Matrizen haben nicht dasselbe Muster oder die Eintraege passen nicht zum Muster.",
+    "Die NUMA Knoten der Speicherseiten konnten nicht abgefragt werden."
 };
 
 Joelix_Fehler joelix_fehler_code = 0;
@@ -0,0 +1,399 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+/* Fuer sched_getaffinity, CPU_SET und pthread_attr_setaffinity_np */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+#include "joelix_error.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
+
+/* Die Hauptschleife jedes Arbeiter-Threads. Der Thread wartet, bis eine neue
+   Aufgabe gestellt wird, fuehrt sie aus und meldet sich danach zurueck. */
+static void * joelix_kontext_arbeiter (void *arg)
+{
+  struct Joelix_Kontext_Arbeiter_t *A = arg;
+  struct Joelix_Kontext_t *K = A->K;
+  unsigned long gesehen = 0; /* Die letzte bearbeitete Aufgabe */
+  Joelix_Kontext_Aufgabe aufgabe;
+  void *daten;
+
+  for (;;) {
+    pthread_mutex_lock (&K->mutex);
+    while (K->generation == gesehen && !K->beenden) {
+      pthread_cond_wait (&K->start, &K->mutex);
+    }
+    if (K->beenden) {
+      pthread_mutex_unlock (&K->mutex);
+      break;
+    }
+    gesehen = K->generation;
+    aufgabe = K->aufgabe;
+    daten = K->daten;
+    pthread_mutex_unlock (&K->mutex);
+
+    aufgabe (daten, A->tid, K->nthreads);
+
+    pthread_mutex_lock (&K->mutex);
+    K->offen--;
+    if (K->offen == 0) pthread_cond_broadcast (&K->fertig);
+    pthread_mutex_unlock (&K->mutex);
+  }
+  return NULL;
+}
+
+/* Beende die ersten nlaufend Threads und gebe den Speicher frei. */
+static void joelix_kontext_befreien (struct Joelix_Kontext_t *K, int nlaufend)
+{
+  int t;
+
+  if (K == NULL) return;
+  if (nlaufend > 0) {
+    pthread_mutex_lock (&K->mutex);
+    K->beenden = 1;
+    pthread_cond_broadcast (&K->start);
+    pthread_mutex_unlock (&K->mutex);
+    for (t = 0;t < nlaufend;t++) pthread_join (K->threads[t], NULL);
+  }
+  pthread_mutex_destroy (&K->mutex);
+  pthread_cond_destroy (&K->start);
+  pthread_cond_destroy (&K->fertig);
+  free (K->threads);
+  free (K->arbeiter);
+  free (K->cpus);
+  free (K->knoten);
+  free (K->teilsummen);
+  free (K->bloecke);
+  free (K);
+}
+
+#ifdef __linux__
+/* Lese die Liste der CPUs eines NUMA Knotens aus sysfs (Format "0-3,8,10-11")
+   und trage in cpu_knoten fuer jede dieser CPUs den Knoten ein. */
+static void joelix_kontext_lese_cpuliste (int knoten, int *cpu_knoten, int ncpus)
+{
+  char pfad[128];
+  FILE *file;
+  int von, bis, c;
+  char trenner;
+
+  sprintf (pfad, "/sys/devices/system/node/node%i/cpulist", knoten);
+  file = fopen (pfad, "r");
+  if (file == NULL) return;
+  while (fscanf (file, "%i", &von) == 1) {
+    bis = von;
+    trenner = (char) fgetc (file);
+    if (trenner == '-') {
+      if (fscanf (file, "%i", &bis) != 1) break;
+      trenner = (char) fgetc (file);
+    }
+    for (c = von;c <= bis && c < ncpus;c++) cpu_knoten[c] = knoten;
+    if (trenner != ',') break;
+  }
+  fclose (file);
+}
+#endif
+
+/* Anzahl der NUMA Knoten. Die Knoten sind in sysfs als node0, node1, ...
+   aufgefuehrt. Wir geben den groessten Index plus eins zurueck. */
+int joelix_kontext_knoten_anzahl (void)
+{
+  int anzahl = 1;
+#ifdef __linux__
+  DIR *dir;
+  struct dirent *eintrag;
+  int k;
+
+  dir = opendir ("/sys/devices/system/node");
+  if (dir == NULL) return 1;
+  while ((eintrag = readdir (dir)) != NULL) {
+    if (sscanf (eintrag->d_name, "node%i", &k) == 1 && k + 1 > anzahl) {
+      anzahl = k + 1;
+    }
+  }
+  closedir (dir);
+#endif
+  return anzahl;
+}
+
+/* Erstelle einen Kontext mit nthreads gebundenen Threads */
+Joelix_Fehler joelix_kontext_init (Joelix_Kontext *pKontext, int nthreads)
+{
+  struct Joelix_Kontext_t *K;
+  int t, ret;
+  pthread_attr_t attr;
+#ifdef __linux__
+  cpu_set_t erlaubt, cpuset;
+  int *liste;      /* Die erlaubten CPUs, sortiert nach Knoten */
+  int *cpu_knoten; /* Der Knoten jeder CPU */
+  int nerlaubt, nknoten, c, i, j, tmp;
+#endif
+
+  if (pKontext == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+
+  K = calloc (1, sizeof (*K));
+  if (K == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  pthread_mutex_init (&K->mutex, NULL);
+  pthread_cond_init (&K->start, NULL);
+  pthread_cond_init (&K->fertig, NULL);
+
+#ifdef __linux__
+  /* Bestimme die erlaubten CPUs und deren Knoten */
+  if (sched_getaffinity (0, sizeof (erlaubt), &erlaubt) != 0) {
+    CPU_ZERO (&erlaubt);
+    CPU_SET (0, &erlaubt);
+  }
+  liste = malloc (CPU_SETSIZE * sizeof (*liste));
+  cpu_knoten = calloc (CPU_SETSIZE, sizeof (*cpu_knoten));
+  if (liste == NULL || cpu_knoten == NULL) {
+    free (liste);
+    free (cpu_knoten);
+    joelix_kontext_befreien (K, 0);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  nknoten = joelix_kontext_knoten_anzahl ();
+  for (i = 0;i < nknoten;i++) joelix_kontext_lese_cpuliste (i, cpu_knoten, CPU_SETSIZE);
+  nerlaubt = 0;
+  for (c = 0;c < CPU_SETSIZE;c++) {
+    if (CPU_ISSET (c, &erlaubt)) liste[nerlaubt++] = c;
+  }
+  /* Sortiere stabil nach Knoten (Insertion-Sort, die Liste ist kurz), damit
+     aufeinanderfolgende Threads, die benachbarte Zeilenbloecke bearbeiten,
+     auf dem gleichen Knoten liegen. */
+  for (i = 1;i < nerlaubt;i++) {
+    tmp = liste[i];
+    for (j = i;j > 0 && cpu_knoten[liste[j-1]] > cpu_knoten[tmp];j--) liste[j] = liste[j-1];
+    liste[j] = tmp;
+  }
+  if (nthreads <= 0) nthreads = nerlaubt;
+#else
+  if (nthreads <= 0) nthreads = 1;
+#endif
+
+  K->nthreads = nthreads;
+  K->threads = malloc (nthreads * sizeof (*K->threads));
+  K->arbeiter = malloc (nthreads * sizeof (*K->arbeiter));
+  K->cpus = malloc (nthreads * sizeof (*K->cpus));
+  K->knoten = malloc (nthreads * sizeof (*K->knoten));
+  K->teilsummen = calloc (nthreads * JOELIX_KONTEXT_TEILSUMMEN_ABSTAND,
+                          sizeof (*K->teilsummen));
+  if (K->threads == NULL || K->arbeiter == NULL || K->cpus == NULL
+      || K->knoten == NULL || K->teilsummen == NULL) {
+#ifdef __linux__
+    free (liste);
+    free (cpu_knoten);
+#endif
+    joelix_kontext_befreien (K, 0);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+
+  /* Verteile die Threads gleichmaessig auf die erlaubten CPUs. Da die Liste
+     nach Knoten sortiert ist, bekommt jeder Knoten einen zusammenhaengenden
+     Block von Threads. */
+  for (t = 0;t < nthreads;t++) {
+#ifdef __linux__
+    K->cpus[t] = liste[(long) t * nerlaubt / nthreads];
+    K->knoten[t] = cpu_knoten[K->cpus[t]];
+#else
+    K->cpus[t] = -1;
+    K->knoten[t] = 0;
+#endif
+  }
+#ifdef __linux__
+  free (liste);
+  free (cpu_knoten);
+#endif
+
+  /* Starte die Arbeiter. Die Bindung an die CPU wird schon beim Erzeugen
+     gesetzt, damit der Thread nie auf einer anderen CPU laeuft. */
+  for (t = 0;t < nthreads;t++) {
+    K->arbeiter[t].K = K;
+    K->arbeiter[t].tid = t;
+    pthread_attr_init (&attr);
+#ifdef __linux__
+    CPU_ZERO (&cpuset);
+    CPU_SET (K->cpus[t], &cpuset);
+    pthread_attr_setaffinity_np (&attr, sizeof (cpuset), &cpuset);
+#endif
+    ret = pthread_create (&K->threads[t], &attr, joelix_kontext_arbeiter,
+                          &K->arbeiter[t]);
+    pthread_attr_destroy (&attr);
+    if (ret != 0) {
+      joelix_kontext_befreien (K, t);
+      return (joelix_fehler_code = F_THREAD_FEHLER);
+    }
+  }
+  *pKontext = K;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Gibt die Anzahl der Threads zurueck */
+int joelix_kontext_threads (Joelix_Kontext K)
+{
+  if (K == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return K->nthreads;
+}
+
+/* Schaltet die reproduzierbaren Reduktionen ein oder aus */
+Joelix_Fehler joelix_kontext_reproduzierbar (Joelix_Kontext K, int ein)
+{
+  if (K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  K->reproduzierbar = (ein != 0);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Gibt die CPU von Thread t zurueck */
+int joelix_kontext_thread_cpu (Joelix_Kontext K, int t)
+{
+  if (K == NULL || t < 0 || t >= K->nthreads) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return K->cpus[t];
+}
+
+/* Gibt den Knoten von Thread t zurueck */
+int joelix_kontext_thread_knoten (Joelix_Kontext K, int t)
+{
+  if (K == NULL || t < 0 || t >= K->nthreads) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return K->knoten[t];
+}
+
+/* Fuehre eine Aufgabe auf allen Threads aus */
+Joelix_Fehler joelix_kontext_ausfuehren (struct Joelix_Kontext_t *K,
+                                         Joelix_Kontext_Aufgabe aufgabe, void *daten)
+{
+  pthread_t selbst = pthread_self ();
+  int t;
+
+  /* Ein Arbeiter kann nicht auf sich selbst warten */
+  for (t = 0;t < K->nthreads;t++) {
+    if (pthread_equal (K->threads[t], selbst)) return (joelix_fehler_code = F_THREAD_FEHLER);
+  }
+  pthread_mutex_lock (&K->mutex);
+  while (K->belegt) pthread_cond_wait (&K->fertig, &K->mutex);
+  K->belegt = 1;
+  K->aufgabe = aufgabe;
+  K->daten = daten;
+  K->offen = K->nthreads;
+  K->generation++;
+  pthread_cond_broadcast (&K->start);
+  while (K->offen > 0) pthread_cond_wait (&K->fertig, &K->mutex);
+  K->belegt = 0;
+  /* Weckt andere Aufrufer, die auf den Kontext warten */
+  pthread_cond_broadcast (&K->fertig);
+  pthread_mutex_unlock (&K->mutex);
+  return F_ERFOLG;
+}
+
+/* Der Bereich von Thread tid */
+void joelix_kontext_bereich (int n, int tid, int nthreads, int *anfang, int *ende)
+{
+  *anfang = (int) ((long) n * tid / nthreads);
+  *ende = (int) ((long) n * (tid + 1) / nthreads);
+}
+
+/* Zaehle die Seiten pro Knoten. move_pages mit nodes == NULL verschiebt
+   nichts, sondern schreibt nur den aktuellen Knoten jeder Seite in status.
+   Gezaehlt wird erst in zaehler, damit seiten bei einem Fehler unveraendert
+   bleibt. */
+Joelix_Fehler joelix_kontext_seiten_platzierung (const void *adresse, size_t bytes,
+                                                 int *seiten, int nknoten)
+{
+#ifdef __linux__
+#define JOELIX_SEITEN_PRO_ABFRAGE 1024
+  void *abfrage[JOELIX_SEITEN_PRO_ABFRAGE];
+  int status[JOELIX_SEITEN_PRO_ABFRAGE];
+  unsigned long seitengroesse, anfang, ende, s;
+  int i, anzahl, ohne_numa = 0;
+  int *zaehler;
+
+  if (seiten == NULL || nknoten < 1) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (adresse == NULL || bytes == 0) return (joelix_fehler_code = F_ERFOLG);
+  zaehler = calloc (nknoten, sizeof (*zaehler));
+  if (zaehler == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  seitengroesse = (unsigned long) sysconf (_SC_PAGESIZE);
+  anfang = (unsigned long) adresse & ~(seitengroesse - 1);
+  ende = (unsigned long) adresse + bytes;
+  for (s = anfang;s < ende;) {
+    for (anzahl = 0;anzahl < JOELIX_SEITEN_PRO_ABFRAGE && s < ende;anzahl++) {
+      abfrage[anzahl] = (void *) s;
+      s += seitengroesse;
+    }
+    if (!ohne_numa
+        && syscall (SYS_move_pages, 0, (unsigned long) anzahl, abfrage, NULL, status, 0) != 0) {
+      if (errno != ENOSYS) {
+        free (zaehler);
+        return (joelix_fehler_code = F_NUMA_FEHLER);
+      }
+      /* Der Kernel kennt kein NUMA, dann liegt alles auf Knoten 0 */
+      ohne_numa = 1;
+    }
+    if (ohne_numa) {
+      zaehler[0] += anzahl;
+      continue;
+    }
+    /* Negative Werte bedeuten, dass die Seite nicht existiert */
+    for (i = 0;i < anzahl;i++) {
+      if (status[i] >= 0 && status[i] < nknoten) zaehler[status[i]]++;
+    }
+  }
+  for (i = 0;i < nknoten;i++) seiten[i] += zaehler[i];
+  free (zaehler);
+#undef JOELIX_SEITEN_PRO_ABFRAGE
+#else
+  if (seiten == NULL || nknoten < 1) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  /* Ohne NUMA Informationen liegt alles auf Knoten 0 */
+  seiten[0] += (int) ((bytes + 4095) / 4096);
+#endif
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Beende den Kontext */
+Joelix_Fehler joelix_kontext_loeschen (Joelix_Kontext *pKontext)
+{
+  if (pKontext == NULL || *pKontext == NULL) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  joelix_kontext_befreien (*pKontext, (*pKontext)->nthreads);
+  *pKontext = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
@@ -30,6 +30,10 @@
 #include "vektor.h"
 #include "matrix_hidden.h"
 #include "matrix.h"
+#include "muster_hidden.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
+#include "optimieren.h"
 
 /* Gebe Speicher von Matrix frei. Wird intern benutzt, weil wir es mehr
    als einer Stelle brauchen.
@@ -37,9 +41,17 @@
 static void joelix_smatrix_befreien (Joelix_sMatrix M)
 {
   if (M == NULL) return;
+  joelix_smatrix_kernel_zuruecksetzen (M);
+  joelix_smatrix_spalten_verwerfen (M);
   free (M->werte);
-  free (M->zeilen_akk);
-  free (M->spalten_ind);
+  if (M->muster != NULL) {
+    /* Die Indices gehoeren dem Muster */
+    joelix_muster_freigeben (M->muster);
+  }
+  else {
+    free (M->zeilen_akk);
+    free (M->spalten_ind);
+  }
   free (M);
 }
 
@@ -55,8 +67,12 @@ Joelix_Fehler joelix_smatrix_init (Joelix_sMatrix *pMatrix, int nzeilen, int nsp
    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
   }
   
-  M = malloc (sizeof (*M));
+  M = calloc (1, sizeof (*M));
   if (M == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER); /* Speicherfehler */
+  /* Bis joelix_smatrix_optimieren aufgerufen wird, benutzen wir die
+     einfache Schleife */
+  M->kernel = JOELIX_SPMV_CSR;
+  M->threads = 1;
   
   /* Setze Parameter von M */
   M->n = nzeilen;
@@ -85,6 +101,97 @@ Joelix_Fehler joelix_smatrix_init (Joelix_sMatrix *pMatrix, int nzeilen, int nsp
   return (joelix_fehler_code = F_ERFOLG);
 }
 
+/* Die Argumente der parallelen Matrixoperationen */
+struct joelix_smatrix_aufgabe
+{
+  Joelix_sMatrix M;
+  double * b;
+  double * x;
+};
+
+/* first touch der Arrays einer neuen Matrix */
+static void joelix_smatrix_init_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_smatrix_aufgabe *a = daten;
+  Joelix_sMatrix M = a->M;
+  int i, anfang, ende;
+
+  /* zeilen_akk gleichmaessig nach Zeilen aufgeteilt, da die Laenge der
+     Zeilen noch nicht bekannt ist. Wie in joelix_smatrix_init wird mit -1
+     vorinitialisiert. */
+  joelix_kontext_bereich (M->n + 1, tid, nthreads, &anfang, &ende);
+  for (i = anfang;i < ende;i++) M->zeilen_akk[i] = -1;
+  /* werte und spalten_ind gleichmaessig aufgeteilt. joelix_smatvec_kontext
+     teilt die Zeilen nach Eintraegen auf, damit jeder Thread auf diesen
+     Seiten rechnet. */
+  joelix_kontext_bereich (M->nnE, tid, nthreads, &anfang, &ende);
+  if (ende > anfang) {
+    memset (M->werte + anfang, 0, (ende - anfang) * sizeof (*M->werte));
+    memset (M->spalten_ind + anfang, 0, (ende - anfang) * sizeof (*M->spalten_ind));
+  }
+}
+
+/* Initialisiere sparse Matrix mit first touch durch die Threads von K */
+Joelix_Fehler joelix_smatrix_init_kontext (Joelix_sMatrix *pMatrix, int nzeilen, int nspalten,
+                                           int nnichtnull, Joelix_Kontext K)
+{
+  Joelix_sMatrix M;
+  struct joelix_smatrix_aufgabe a;
+
+  if (pMatrix == NULL || nzeilen < 0 || nspalten < 0 || nnichtnull < 0 || K == NULL) {
+   return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  M = calloc (1, sizeof (*M));
+  if (M == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  M->kernel = JOELIX_SPMV_CSR;
+  M->threads = 1;
+  M->n = nzeilen;
+  M->m = nspalten;
+  M->nnE = nnichtnull;
+  /* Kein calloc: Die Seiten sollen erst von den Threads beschrieben werden */
+  M->werte = malloc ((M->nnE > 0 ? M->nnE : 1) * sizeof (*M->werte));
+  M->zeilen_akk = malloc ((M->n + 1) * sizeof (*M->zeilen_akk));
+  M->spalten_ind = malloc ((M->nnE > 0 ? M->nnE : 1) * sizeof (*M->spalten_ind));
+  if (M->werte == NULL || M->zeilen_akk == NULL || M->spalten_ind == NULL) {
+    joelix_smatrix_befreien (M);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  a.M = M;
+  if (joelix_kontext_ausfuehren (K, joelix_smatrix_init_aufgabe, &a) != F_ERFOLG) {
+    joelix_smatrix_befreien (M);
+    return joelix_fehler_code;
+  }
+  M->zeilen_akk[0] = 0;
+  *pMatrix = M;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Die Werte einer Zeile einer Matrix mit gemeinsamem Muster eintragen. Die
+   Spalten muessen genau die des Musters sein. Da sich das Muster nicht
+   aendert, bleibt der ausgewaehlte Kernel gueltig und die Zeilen koennen
+   in beliebiger Reihenfolge befuellt werden. */
+static Joelix_Fehler joelix_smatrix_fuelleZeile_muster (Joelix_sMatrix M, int zeile,
+                                                        int znichtnull, double * werte,
+                                                        int * spalten)
+{
+  int j, anfang;
+
+  if (zeile < 0 || zeile >= M->n) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  anfang = M->zeilen_akk[zeile];
+  if (znichtnull != M->zeilen_akk[zeile+1] - anfang) {
+    return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  }
+  for (j = 0;j < znichtnull;j++) {
+    if (spalten[j] != M->spalten_ind[anfang + j]) return (joelix_fehler_code = F_FALSCHES_MUSTER);
+  }
+  memcpy (M->werte + anfang, werte, znichtnull * sizeof (*werte));
+  /* Die ELLPACK Kopie muss mit geaendert werden */
+  if (M->kernel == JOELIX_SPMV_ELL) {
+    for (j = 0;j < znichtnull;j++) M->ell_werte[(long) j * M->n + zeile] = werte[j];
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
 /* Eine neue Zeile einer smatrix befuellen. Wir gehen davon aus, dass die Zeilen
    in aufsteigender Reihenfolge befuellt werden. Nullzeilen koennen dabei ueber-
    sprungen werden.
@@ -98,6 +205,13 @@ Joelix_Fehler joelix_smatrix_fuelleZeile (Joelix_sMatrix M, int zeile,
   int frueherer_index; /* Speichert den letzten eingetragenen index in zeilen_akk */
 
   if ( M == NULL ) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  /* Bei einem gemeinsamen Muster werden nur die Werte eingetragen */
+  if (M->muster != NULL) return joelix_smatrix_fuelleZeile_muster (M, zeile, znichtnull,
+                                                                  werte, spalten);
+  /* Die Matrix aendert sich, ein ausgewaehlter Kernel passt nicht mehr */
+  if (M->kernel != JOELIX_SPMV_CSR || M->threads > 1) joelix_smatrix_kernel_zuruecksetzen (M);
+  /* Ebenso der Spaltenzugriff */
+  if (M->csc_akk != NULL) joelix_smatrix_spalten_verwerfen (M);
 #if 0
   if (M->zeilen_akk[zeile+1] >= 0) {
     /* Diese Zeile wurde schon befuellt. Neue Werte werden nicht eingefuellt. */
@@ -142,11 +256,18 @@ Joelix_Fehler joelix_smatrix_fuelleZeile (Joelix_sMatrix M, int zeile,
      * werden alle kommenden Werte aufgefuellt. */
     if (frueherer_index + znichtnull == M->nnE) {
       for (j = zeile + 1;j < M->n+1;j++) M->zeilen_akk[j] = M->nnE;
+      M->befuellt = 1;
     }
   }
   return (joelix_fehler_code = F_ERFOLG);
 }
 
+/* Bei nnE == 0 steht in zeilen_akk noch die Markierung -1 */
+int joelix_smatrix_ist_befuellt (struct Joelix_sparse_Matrix_t * M)
+{
+  return M->nnE == 0 || M->befuellt;
+}
+
 /* Fordere die Anzahl der Zeilen an. */
 int joelix_smatrix_get_zeilen(Joelix_sMatrix M)
 {
@@ -177,27 +298,25 @@ int joelix_smatrix_get_spalten(Joelix_sMatrix M)
 Joelix_Fehler joelix_smatrix_aendernneintrag (Joelix_sMatrix M, int zeile,
                                               int spalte, double wert)
 {
-  int j;
-  int found = 0;
+  int j, k;
 
   if (M == NULL || zeile < 0 || zeile >= M->n
       || spalte < 0 || spalte >= M->m) return F_FALSCHE_PARAMETER;
 
   /* Wir suchen in den nicht-null Eintraegen zu der Zeile nach dem passenden
-   * Spalteneintrag */
-  j = M->zeilen_akk[zeile];
-  while (!found) {
-    if (M->spalten_ind[j] == spalte) {
-      found = 1;
-    }
-    else {
-      /* Der Spaltenindex existiert nicht */
-      if (j >= M->zeilen_akk[zeile+1]) found = -1;
-      j++;
-    }
+   * Spalteneintrag. Das Ende der Zeile wird vor dem Spaltenindex geprueft,
+   * sonst wuerde der erste Eintrag der naechsten Zeile gefunden. */
+  for (j = M->zeilen_akk[zeile];j < M->zeilen_akk[zeile+1];j++) {
+    if (M->spalten_ind[j] == spalte) break;
+  }
+  /* Der Spaltenindex existiert nicht */
+  if (j >= M->zeilen_akk[zeile+1]) return F_FALSCHE_PARAMETER;
+  /* Die ELLPACK Kopie muss mit geaendert werden */
+  k = j - M->zeilen_akk[zeile];
+  if (M->kernel == JOELIX_SPMV_ELL) {
+    if (k >= M->ell_breite) return F_FALSCHER_INDEX;
+    M->ell_werte[(long) k * M->n + zeile] = wert;
   }
-  /* Falls der Eintrag nicht gefunden wurde */
-  if (found < 0) return F_FALSCHE_PARAMETER;
   /* Der Eintrag wurde gefunden und ist an Stelle j im Array werte */
   M->werte[j] = wert;
   return F_ERFOLG;
@@ -214,6 +333,12 @@ Joelix_Fehler joelix_smatvec (Joelix_Vektor b, Joelix_sMatrix M, Joelix_Vektor x
     return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
   }
 
+  /* Wurde mit joelix_smatrix_optimieren ein anderer Kernel ausgewaehlt? */
+  if (M->kernel != JOELIX_SPMV_CSR || M->threads > 1) {
+    if (joelix_smatvec_optimiert (b->werte, M, x->werte) != F_ERFOLG) return joelix_fehler_code;
+    return (joelix_fehler_code = F_ERFOLG);
+  }
+
   for (i = 0;i < M->n;i++) {
     /* Schleife ueber alle Zeilen der Matrix */
     b->werte[i] = 0;
@@ -227,6 +352,154 @@ Joelix_Fehler joelix_smatvec (Joelix_Vektor b, Joelix_sMatrix M, Joelix_Vektor x
   return (joelix_fehler_code = F_ERFOLG);
 }
 
+/* Der Spaltenzugriff wird mit einem Counting Sort ueber die Spaltenindices
+   aufgebaut. Innerhalb einer Spalte sind die Zeilen danach aufsteigend. */
+Joelix_Fehler joelix_smatrix_spalten_aufbauen (struct Joelix_sparse_Matrix_t * M)
+{
+  int i, j, k, p;
+
+  if (M->csc_akk != NULL) return F_ERFOLG;
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  M->csc_akk = calloc (M->m + 1, sizeof (*M->csc_akk));
+  M->csc_zeilen = malloc ((M->nnE > 0 ? M->nnE : 1) * sizeof (*M->csc_zeilen));
+  M->csc_stelle = malloc ((M->nnE > 0 ? M->nnE : 1) * sizeof (*M->csc_stelle));
+  if (M->csc_akk == NULL || M->csc_zeilen == NULL || M->csc_stelle == NULL) {
+    joelix_smatrix_spalten_verwerfen (M);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  if (M->nnE == 0) return F_ERFOLG;
+  /* Eintraege pro Spalte zaehlen und aufsummieren */
+  for (k = 0;k < M->nnE;k++) M->csc_akk[M->spalten_ind[k] + 1]++;
+  for (j = 0;j < M->m;j++) M->csc_akk[j + 1] += M->csc_akk[j];
+  /* Einsortieren, csc_akk[j] zeigt dabei auf den naechsten freien Platz
+     von Spalte j */
+  for (i = 0;i < M->n;i++) {
+    for (k = M->zeilen_akk[i];k < M->zeilen_akk[i+1];k++) {
+      p = M->csc_akk[M->spalten_ind[k]]++;
+      M->csc_zeilen[p] = i;
+      M->csc_stelle[p] = k;
+    }
+  }
+  /* Jetzt steht in csc_akk[j] der Anfang von Spalte j+1 */
+  for (j = M->m;j > 0;j--) M->csc_akk[j] = M->csc_akk[j - 1];
+  M->csc_akk[0] = 0;
+  return F_ERFOLG;
+}
+
+void joelix_smatrix_spalten_verwerfen (struct Joelix_sparse_Matrix_t * M)
+{
+  free (M->csc_akk);
+  free (M->csc_zeilen);
+  free (M->csc_stelle);
+  M->csc_akk = NULL;
+  M->csc_zeilen = NULL;
+  M->csc_stelle = NULL;
+}
+
+/* Spaltenzugriff im Voraus aufbauen */
+Joelix_Fehler joelix_smatrix_spaltenzugriff (Joelix_sMatrix M)
+{
+  if (M == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (joelix_smatrix_spalten_aufbauen (M) != F_ERFOLG) return joelix_fehler_code;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Y = MX fuer nvek Vektoren */
+void joelix_smatvec_mehrfach (double * Y, struct Joelix_sparse_Matrix_t * M,
+                              const double * X, int nvek)
+{
+  int i, k, v;
+  double wert, *y;
+  const double *x;
+
+  for (i = 0;i < M->n;i++) {
+    y = Y + (long) i * nvek;
+    for (v = 0;v < nvek;v++) y[v] = 0;
+    for (k = M->zeilen_akk[i];k < M->zeilen_akk[i+1];k++) {
+      /* Ein Wert der Matrix, angewendet auf die ganze Zeile von X */
+      wert = M->werte[k];
+      x = X + (long) M->spalten_ind[k] * nvek;
+      for (v = 0;v < nvek;v++) y[v] += wert * x[v];
+    }
+  }
+}
+
+/* Die erste Zeile, vor der mindestens nnE*t/nthreads Eintraege liegen, wie
+   bei den grenzen in joelix_smatrix_setze_kernel */
+static int joelix_smatrix_grenze (Joelix_sMatrix M, int t, int nthreads)
+{
+  long ziel = (long) M->nnE * t / nthreads;
+  int unten = 0, oben = M->n, mitte;
+
+  if (t >= nthreads) return M->n;
+  while (unten < oben) {
+    mitte = unten + (oben - unten) / 2;
+    if (M->zeilen_akk[mitte] < ziel) unten = mitte + 1;
+    else oben = mitte;
+  }
+  return unten;
+}
+
+/* Berechnet die Zeilen von Thread tid in b = Mx. Die Zeilen sind nach
+   Eintraegen aufgeteilt, so wie werte und spalten_ind beim first touch in
+   joelix_smatrix_init_aufgabe. */
+static void joelix_smatvec_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_smatrix_aufgabe *a = daten;
+  Joelix_sMatrix M = a->M;
+  int i, k, anfang, ende;
+  double summe;
+
+  anfang = joelix_smatrix_grenze (M, tid, nthreads);
+  ende = joelix_smatrix_grenze (M, tid + 1, nthreads);
+  for (i = anfang;i < ende;i++) {
+    summe = 0;
+    for (k = M->zeilen_akk[i];k < M->zeilen_akk[i+1];k++) {
+      summe += M->werte[k] * a->x[M->spalten_ind[k]];
+    }
+    a->b[i] = summe;
+  }
+}
+
+/* b = Mx matrix-vektor Produkt, parallel */
+Joelix_Fehler joelix_smatvec_kontext (Joelix_Vektor b, Joelix_sMatrix M, Joelix_Vektor x,
+                                      Joelix_Kontext K)
+{
+  struct joelix_smatrix_aufgabe a;
+
+  if (b == NULL || M == NULL || x == NULL || K == NULL) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (b->laenge != M->n || x->laenge != M->m) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  a.M = M;
+  a.b = b->werte;
+  a.x = x->werte;
+  if (joelix_kontext_ausfuehren (K, joelix_smatvec_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Auf welchen Knoten liegt M? */
+Joelix_Fehler joelix_smatrix_platzierung (Joelix_sMatrix M, int *seiten, int nknoten)
+{
+  int k;
+
+  if (M == NULL || seiten == NULL || nknoten < 1) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  for (k = 0;k < nknoten;k++) seiten[k] = 0;
+  if (joelix_kontext_seiten_platzierung (M->werte, M->nnE * sizeof (*M->werte),
+                                         seiten, nknoten) != F_ERFOLG
+      || joelix_kontext_seiten_platzierung (M->zeilen_akk, (M->n + 1) * sizeof (*M->zeilen_akk),
+                                            seiten, nknoten) != F_ERFOLG
+      || joelix_kontext_seiten_platzierung (M->spalten_ind, M->nnE * sizeof (*M->spalten_ind),
+                                            seiten, nknoten) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
 
 /* Gebe Matrix auf Konsole aus */
 Joelix_Fehler joelix_smatrix_print (const Joelix_sMatrix M)
@@ -0,0 +1,288 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
+#include "optimieren.h"
+#include "muster_hidden.h"
+#include "muster.h"
+
+/* Pruefe ein CSR Muster mit n Zeilen, m Spalten und nnE Eintraegen */
+static int joelix_muster_ok (int n, int m, int nnE, const int *zeilen_akk,
+                             const int *spalten_ind)
+{
+  int i, k;
+
+  if (zeilen_akk == NULL || (nnE > 0 && spalten_ind == NULL)) return 0;
+  if (zeilen_akk[0] != 0 || zeilen_akk[n] != nnE) return 0;
+  for (i = 0;i < n;i++) {
+    if (zeilen_akk[i + 1] < zeilen_akk[i]) return 0;
+  }
+  for (k = 0;k < nnE;k++) {
+    if (spalten_ind[k] < 0 || spalten_ind[k] >= m) return 0;
+  }
+  return 1;
+}
+
+/* Ein neues Muster mit einer Referenz */
+Joelix_Fehler joelix_muster_init (Joelix_Muster *pMuster, int n, int m, int nnE,
+                                  const int *zeilen_akk, const int *spalten_ind)
+{
+  Joelix_Muster P;
+
+  if (pMuster == NULL || n < 0 || m < 0 || nnE < 0
+      || !joelix_muster_ok (n, m, nnE, zeilen_akk, spalten_ind)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  P = malloc (sizeof (*P));
+  if (P == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  P->zeilen_akk = malloc ((n + 1) * sizeof (*P->zeilen_akk));
+  P->spalten_ind = malloc ((nnE > 0 ? nnE : 1) * sizeof (*P->spalten_ind));
+  if (P->zeilen_akk == NULL || P->spalten_ind == NULL) {
+    free (P->zeilen_akk);
+    free (P->spalten_ind);
+    free (P);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  memcpy (P->zeilen_akk, zeilen_akk, (n + 1) * sizeof (*P->zeilen_akk));
+  if (nnE > 0) memcpy (P->spalten_ind, spalten_ind, nnE * sizeof (*P->spalten_ind));
+  P->n = n;
+  P->m = m;
+  P->nnE = nnE;
+  P->referenzen = 1;
+  *pMuster = P;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Das Muster uebernimmt die Indices von M */
+Joelix_Fehler joelix_muster_aus_smatrix (Joelix_Muster *pMuster, Joelix_sMatrix M)
+{
+  Joelix_Muster P;
+
+  if (pMuster == NULL || M == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (M->muster != NULL) {
+    M->muster->referenzen++;
+    *pMuster = M->muster;
+    return (joelix_fehler_code = F_ERFOLG);
+  }
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  P = malloc (sizeof (*P));
+  if (P == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  /* Bei einer Matrix ohne Eintraege steht in zeilen_akk noch die Markierung
+     von joelix_smatrix_fuelleZeile */
+  if (M->nnE == 0) memset (M->zeilen_akk, 0, (M->n + 1) * sizeof (*M->zeilen_akk));
+  P->n = M->n;
+  P->m = M->m;
+  P->nnE = M->nnE;
+  P->zeilen_akk = M->zeilen_akk;
+  P->spalten_ind = M->spalten_ind;
+  /* Eine Referenz fuer das Handle und eine fuer M */
+  P->referenzen = 2;
+  M->muster = P;
+  *pMuster = P;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Eine Matrix mit den Indices von P */
+Joelix_Fehler joelix_smatrix_init_muster (Joelix_sMatrix *pMatrix, Joelix_Muster P)
+{
+  Joelix_sMatrix M;
+
+  if (pMatrix == NULL || P == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  M = calloc (1, sizeof (*M));
+  if (M == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  M->werte = calloc (P->nnE > 0 ? P->nnE : 1, sizeof (*M->werte));
+  if (M->werte == NULL) {
+    free (M);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  M->kernel = JOELIX_SPMV_CSR;
+  M->threads = 1;
+  M->n = P->n;
+  M->m = P->m;
+  M->nnE = P->nnE;
+  M->zeilen_akk = P->zeilen_akk;
+  M->spalten_ind = P->spalten_ind;
+  M->befuellt = 1;
+  M->muster = P;
+  P->referenzen++;
+  *pMatrix = M;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+int joelix_muster_referenzen (Joelix_Muster P)
+{
+  if (P == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return P->referenzen;
+}
+
+void joelix_muster_freigeben (struct Joelix_Muster_t * P)
+{
+  if (P == NULL) return;
+  P->referenzen--;
+  if (P->referenzen > 0) return;
+  free (P->zeilen_akk);
+  free (P->spalten_ind);
+  free (P);
+}
+
+Joelix_Fehler joelix_muster_loeschen (Joelix_Muster *pMuster)
+{
+  if (pMuster == NULL || *pMuster == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_muster_freigeben (*pMuster);
+  *pMuster = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Haben A und B dieselben Indices? Das gilt fuer Matrizen mit demselben
+   Muster und fuer A = B. */
+static int joelix_gleiches_muster (Joelix_sMatrix A, Joelix_sMatrix B)
+{
+  return A->n == B->n && A->m == B->m && A->nnE == B->nnE
+         && A->zeilen_akk == B->zeilen_akk && A->spalten_ind == B->spalten_ind;
+}
+
+/* Die Argumente der Linearkombinationen */
+struct joelix_kombination_aufgabe
+{
+  Joelix_sMatrix A, B, C;
+  double a, b;
+  const double * x;
+  double * y;
+};
+
+/* C = aA + bB fuer den Anteil von Thread tid. Hat C eine ELLPACK Kopie, wird
+   nach Zeilen aufgeteilt, damit die Kopie im selben Durchlauf geaendert
+   werden kann, sonst gleichmaessig nach Eintraegen. */
+static void joelix_kombination_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_kombination_aufgabe *t = daten;
+  const double *wa = t->A->werte, *wb = t->B->werte;
+  double *wc = t->C->werte, *ell, a = t->a, b = t->b;
+  const int *z = t->C->zeilen_akk;
+  int i, k, anfang, ende, n = t->C->n;
+
+  if (t->C->kernel == JOELIX_SPMV_ELL) {
+    ell = t->C->ell_werte;
+    joelix_kontext_bereich (n, tid, nthreads, &anfang, &ende);
+    for (i = anfang;i < ende;i++) {
+      for (k = z[i];k < z[i+1];k++) {
+        wc[k] = a * wa[k] + b * wb[k];
+        ell[(long) (k - z[i]) * n + i] = wc[k];
+      }
+    }
+  }
+  else {
+    joelix_kontext_bereich (t->C->nnE, tid, nthreads, &anfang, &ende);
+    for (k = anfang;k < ende;k++) wc[k] = a * wa[k] + b * wb[k];
+  }
+}
+
+/* C = aA + bB */
+Joelix_Fehler joelix_smatrix_linearkombination (Joelix_sMatrix C, double a, Joelix_sMatrix A,
+                                                double b, Joelix_sMatrix B, Joelix_Kontext K)
+{
+  struct joelix_kombination_aufgabe t;
+
+  if (C == NULL || A == NULL || B == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (!joelix_gleiches_muster (A, B) || !joelix_gleiches_muster (A, C)) {
+    return (joelix_fehler_code = F_FALSCHES_MUSTER);
+  }
+  t.A = A;
+  t.B = B;
+  t.C = C;
+  t.a = a;
+  t.b = b;
+  if (K != NULL) {
+    if (joelix_kontext_ausfuehren (K, joelix_kombination_aufgabe, &t) != F_ERFOLG) {
+      return joelix_fehler_code;
+    }
+  }
+  else joelix_kombination_aufgabe (&t, 0, 1);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* y = (aA + bB) x fuer die Zeilen von Thread tid. Beide Matrizen werden mit
+   demselben Spaltenindex multipliziert. */
+static void joelix_kombination_smatvec_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_kombination_aufgabe *t = daten;
+  const double *wa = t->A->werte, *wb = t->B->werte, *x = t->x;
+  const int *z = t->A->zeilen_akk, *s = t->A->spalten_ind;
+  int i, k, anfang, ende;
+  double summe_a, summe_b, xk;
+
+  joelix_kontext_bereich (t->A->n, tid, nthreads, &anfang, &ende);
+  for (i = anfang;i < ende;i++) {
+    summe_a = 0;
+    summe_b = 0;
+    for (k = z[i];k < z[i+1];k++) {
+      xk = x[s[k]];
+      summe_a += wa[k] * xk;
+      summe_b += wb[k] * xk;
+    }
+    t->y[i] = t->a * summe_a + t->b * summe_b;
+  }
+}
+
+/* y = (aA + bB) x */
+Joelix_Fehler joelix_smatvec_linearkombination (Joelix_Vektor y, double a, Joelix_sMatrix A,
+                                                double b, Joelix_sMatrix B, Joelix_Vektor x,
+                                                Joelix_Kontext K)
+{
+  struct joelix_kombination_aufgabe t;
+
+  if (y == NULL || A == NULL || B == NULL || x == NULL || y == x) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (!joelix_gleiches_muster (A, B)) return (joelix_fehler_code = F_FALSCHES_MUSTER);
+  if (!joelix_smatrix_ist_befuellt (A)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  if (y->laenge != A->n || x->laenge != A->m) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  t.A = A;
+  t.B = B;
+  t.a = a;
+  t.b = b;
+  t.x = x->werte;
+  t.y = y->werte;
+  if (K != NULL) {
+    if (joelix_kontext_ausfuehren (K, joelix_kombination_smatvec_aufgabe, &t) != F_ERFOLG) {
+      return joelix_fehler_code;
+    }
+  }
+  else joelix_kombination_smatvec_aufgabe (&t, 0, 1);
+  return (joelix_fehler_code = F_ERFOLG);
+}
@@ -0,0 +1,367 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "operator_hidden.h"
+#include "operator.h"
+
+extern Joelix_Fehler joelix_fehler_code;
+
+/* Ein neuer Operator */
+static Joelix_Fehler joelix_operator_anlegen (Joelix_Operator *pOperator, int n, int m,
+                                              Joelix_Operator_Funktion anwenden,
+                                              Joelix_Operator_Mehrfach mehrfach, void *daten,
+                                              void (*befreien) (void *daten))
+{
+  Joelix_Operator A;
+
+  A = malloc (sizeof (*A));
+  if (A == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  A->n = n;
+  A->m = m;
+  A->anwenden = anwenden;
+  A->mehrfach = mehrfach;
+  A->daten = daten;
+  A->befreien = befreien;
+  *pOperator = A;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Operator aus eigenen Funktionen */
+Joelix_Fehler joelix_operator_init (Joelix_Operator *pOperator, int n, int m,
+                                    Joelix_Operator_Funktion anwenden,
+                                    Joelix_Operator_Mehrfach mehrfach, void *daten)
+{
+  if (pOperator == NULL || n < 0 || m < 0 || anwenden == NULL) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  return joelix_operator_anlegen (pOperator, n, m, anwenden, mehrfach, daten, NULL);
+}
+
+/* Die gespeicherte Matrix als Operator */
+static Joelix_Fehler joelix_operator_smatrix_anwenden (double *y, const double *x, void *daten)
+{
+  return joelix_smatvec_optimiert (y, daten, x);
+}
+
+static Joelix_Fehler joelix_operator_smatrix_mehrfach (double *Y, const double *X, int nvek,
+                                                       void *daten)
+{
+  joelix_smatvec_mehrfach (Y, daten, X, nvek);
+  return F_ERFOLG;
+}
+
+void joelix_operator_smatrix_setzen (struct Joelix_Operator_t * A,
+                                     struct Joelix_sparse_Matrix_t * M)
+{
+  A->n = M->n;
+  A->m = M->m;
+  A->anwenden = joelix_operator_smatrix_anwenden;
+  A->mehrfach = joelix_operator_smatrix_mehrfach;
+  A->daten = M;
+  A->befreien = NULL;
+}
+
+Joelix_Fehler joelix_operator_aus_smatrix (Joelix_Operator *pOperator, Joelix_sMatrix M)
+{
+  if (pOperator == NULL || M == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  return joelix_operator_anlegen (pOperator, M->n, M->m, joelix_operator_smatrix_anwenden,
+                                  joelix_operator_smatrix_mehrfach, M, NULL);
+}
+
+/* Die Stencils. Ein Stencil wird als Liste von Gitterzeilen (dz, dy)
+   beschrieben. Aus jeder Gitterzeile kommen die Punkte dx = -1, 0, 1 (links,
+   mitte, rechts) mit den angegebenen Koeffizienten, -1 heisst, der Punkt
+   gehoert nicht zum Stencil. */
+struct joelix_stencil_zeile
+{
+  int dz, dy;
+  int links, mitte, rechts;
+};
+
+static const struct joelix_stencil_zeile joelix_stencil_5[3] = {
+  {0, -1, -1, 0, -1}, {0, 0, 1, 2, 3}, {0, 1, -1, 4, -1}
+};
+
+static const struct joelix_stencil_zeile joelix_stencil_7[5] = {
+  {-1, 0, -1, 0, -1}, {0, -1, -1, 1, -1}, {0, 0, 2, 3, 4}, {0, 1, -1, 5, -1}, {1, 0, -1, 6, -1}
+};
+
+static const struct joelix_stencil_zeile joelix_stencil_27[9] = {
+  {-1, -1, 0, 1, 2}, {-1, 0, 3, 4, 5}, {-1, 1, 6, 7, 8},
+  {0, -1, 9, 10, 11}, {0, 0, 12, 13, 14}, {0, 1, 15, 16, 17},
+  {1, -1, 18, 19, 20}, {1, 0, 21, 22, 23}, {1, 1, 24, 25, 26}
+};
+
+/* Die Daten eines Stencil-Operators */
+struct joelix_stencil
+{
+  const struct joelix_stencil_zeile *zeilen;
+  int nzeilen;
+  int npunkte;
+  int nx, ny, nz;
+  int variabel;
+  double *koeff; /* npunkte Werte, oder npunkte * nx ny nz Werte */
+};
+
+/* Die Gitterpunkte werden in Kacheln von JOELIX_STENCIL_BLOCK_X mal
+   JOELIX_STENCIL_BLOCK_Y Punkten durchlaufen, jeweils fuer alle z. Die
+   benutzten Zeilen der Nachbarebenen bleiben so im Cache. */
+#define JOELIX_STENCIL_BLOCK_X 256
+#define JOELIX_STENCIL_BLOCK_Y 8
+
+/* Die innersten Schleifen gibt es fuer konstante und variable Koeffizienten.
+   Sie werden mit den folgenden Makros erzeugt, so dass jede Variante ohne
+   Abfragen in der Schleife auskommt und vom Compiler vektorisiert werden
+   kann. K (k, x) ist der Koeffizient an Stelle x der Gitterzeile. */
+#define JOELIX_K_KONSTANT(k, x) (k)
+#define JOELIX_K_VARIABEL(k, x) ((k)[x])
+
+/* y[x] += k r[x] fuer x0 <= x < x1 */
+#define JOELIX_STENCIL_PUNKT(NAME, TYP, K)                                   \
+static void NAME (double *y, const double *r, int x0, int x1, TYP km)        \
+{                                                                            \
+  int x;                                                                     \
+                                                                             \
+  for (x = x0;x < x1;x++) y[x] += K (km, x) * r[x];                          \
+}
+
+/* y[x] += kl r[x-1] + km r[x] + kr r[x+1] fuer x0 <= x < x1, ohne die
+   Punkte ausserhalb von 0 <= x < nx */
+#define JOELIX_STENCIL_DREI(NAME, TYP, K)                                    \
+static void NAME (double *y, const double *r, int x0, int x1, int nx,        \
+                  TYP kl, TYP km, TYP kr)                                    \
+{                                                                            \
+  int x, a = x0, b = x1;                                                     \
+                                                                             \
+  if (a == 0) {                                                              \
+    y[0] += K (km, 0) * r[0] + (nx > 1 ? K (kr, 0) * r[1] : 0);              \
+    a = 1;                                                                   \
+  }                                                                          \
+  if (b == nx && b > a) {                                                    \
+    b = nx - 1;                                                              \
+    y[b] += K (kl, b) * r[b - 1] + K (km, b) * r[b];                         \
+  }                                                                          \
+  for (x = a;x < b;x++) {                                                    \
+    y[x] += K (kl, x) * r[x - 1] + K (km, x) * r[x] + K (kr, x) * r[x + 1];  \
+  }                                                                          \
+}
+
+JOELIX_STENCIL_PUNKT (joelix_stencil_punkt_konstant, double, JOELIX_K_KONSTANT)
+JOELIX_STENCIL_PUNKT (joelix_stencil_punkt_variabel, const double *, JOELIX_K_VARIABEL)
+JOELIX_STENCIL_DREI (joelix_stencil_drei_konstant, double, JOELIX_K_KONSTANT)
+JOELIX_STENCIL_DREI (joelix_stencil_drei_variabel, const double *, JOELIX_K_VARIABEL)
+
+/* Die Beitraege einer Gitterzeile r des Stencils zur Gitterzeile y.
+   basis ist die Zeile von y[0] im Operator. */
+static void joelix_stencil_zeile_anwenden (const struct joelix_stencil *S,
+                                           const struct joelix_stencil_zeile *z,
+                                           double *y, const double *r, long basis,
+                                           int x0, int x1)
+{
+  long N = (long) S->nx * S->ny * S->nz;
+  const double *k = S->koeff;
+
+  if (!S->variabel) {
+    if (z->links < 0) {
+      joelix_stencil_punkt_konstant (y, r, x0, x1, k[z->mitte]);
+    } else {
+      joelix_stencil_drei_konstant (y, r, x0, x1, S->nx, k[z->links], k[z->mitte],
+                                    k[z->rechts]);
+    }
+  } else {
+    if (z->links < 0) {
+      joelix_stencil_punkt_variabel (y, r, x0, x1, k + z->mitte * N + basis);
+    } else {
+      joelix_stencil_drei_variabel (y, r, x0, x1, S->nx, k + z->links * N + basis,
+                                    k + z->mitte * N + basis, k + z->rechts * N + basis);
+    }
+  }
+}
+
+/* y = Ax fuer einen Stencil */
+static Joelix_Fehler joelix_stencil_anwenden (double *y, const double *x, void *daten)
+{
+  const struct joelix_stencil *S = daten;
+  const struct joelix_stencil_zeile *z;
+  int xb, xe, yb, ye, iy, iz, jy, jz, l;
+  long basis;
+
+  for (yb = 0;yb < S->ny;yb += JOELIX_STENCIL_BLOCK_Y) {
+    ye = yb + JOELIX_STENCIL_BLOCK_Y < S->ny ? yb + JOELIX_STENCIL_BLOCK_Y : S->ny;
+    for (xb = 0;xb < S->nx;xb += JOELIX_STENCIL_BLOCK_X) {
+      xe = xb + JOELIX_STENCIL_BLOCK_X < S->nx ? xb + JOELIX_STENCIL_BLOCK_X : S->nx;
+      for (iz = 0;iz < S->nz;iz++) {
+        for (iy = yb;iy < ye;iy++) {
+          basis = ((long) iz * S->ny + iy) * S->nx;
+          memset (y + basis + xb, 0, (xe - xb) * sizeof (*y));
+          for (l = 0;l < S->nzeilen;l++) {
+            z = S->zeilen + l;
+            jz = iz + z->dz;
+            jy = iy + z->dy;
+            if (jz < 0 || jz >= S->nz || jy < 0 || jy >= S->ny) continue;
+            joelix_stencil_zeile_anwenden (S, z, y + basis, x + ((long) jz * S->ny + jy) * S->nx,
+                                           basis, xb, xe);
+          }
+        }
+      }
+    }
+  }
+  return F_ERFOLG;
+}
+
+static void joelix_stencil_befreien (void *daten)
+{
+  struct joelix_stencil *S = daten;
+
+  free (S->koeff);
+  free (S);
+}
+
+/* Ein Stencil-Operator */
+Joelix_Fehler joelix_operator_stencil (Joelix_Operator *pOperator, Joelix_Stencil art,
+                                       int nx, int ny, int nz, const double *koeff,
+                                       int variabel)
+{
+  struct joelix_stencil *S;
+  long N, anzahl;
+
+  if (pOperator == NULL || koeff == NULL || nx < 1 || ny < 1 || nz < 1) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  N = (long) nx * ny * nz;
+  if (N > 2147483647L || (art == JOELIX_STENCIL_5 && nz != 1)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  S = malloc (sizeof (*S));
+  if (S == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  switch (art) {
+    case JOELIX_STENCIL_5:
+      S->zeilen = joelix_stencil_5;
+      S->nzeilen = 3;
+      S->npunkte = 5;
+      break;
+    case JOELIX_STENCIL_7:
+      S->zeilen = joelix_stencil_7;
+      S->nzeilen = 5;
+      S->npunkte = 7;
+      break;
+    case JOELIX_STENCIL_27:
+      S->zeilen = joelix_stencil_27;
+      S->nzeilen = 9;
+      S->npunkte = 27;
+      break;
+    default:
+      free (S);
+      return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  S->nx = nx;
+  S->ny = ny;
+  S->nz = nz;
+  S->variabel = variabel ? 1 : 0;
+  anzahl = S->variabel ? S->npunkte * N : S->npunkte;
+  S->koeff = malloc (anzahl * sizeof (*S->koeff));
+  if (S->koeff == NULL) {
+    free (S);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  memcpy (S->koeff, koeff, anzahl * sizeof (*S->koeff));
+  if (joelix_operator_anlegen (pOperator, (int) N, (int) N, joelix_stencil_anwenden, NULL, S,
+                               joelix_stencil_befreien) != F_ERFOLG) {
+    joelix_stencil_befreien (S);
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+int joelix_operator_zeilen (Joelix_Operator A)
+{
+  if (A == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return A->n;
+}
+
+int joelix_operator_spalten (Joelix_Operator A)
+{
+  if (A == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return A->m;
+}
+
+/* b = Ax */
+Joelix_Fehler joelix_opvec (Joelix_Vektor b, Joelix_Operator A, Joelix_Vektor x)
+{
+  if (b == NULL || A == NULL || x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (b->laenge != A->n || x->laenge != A->m) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  return (joelix_fehler_code = A->anwenden (b->werte, x->werte, A->daten));
+}
+
+/* Y = AX fuer nvek zeilenweise gespeicherte Vektoren */
+Joelix_Fehler joelix_operator_mehrfach (double * Y, struct Joelix_Operator_t * A,
+                                        const double * X, int nvek)
+{
+  double *x, *y;
+  Joelix_Fehler fehler = F_ERFOLG;
+  int i, v;
+
+  if (A->mehrfach != NULL) return A->mehrfach (Y, X, nvek, A->daten);
+  /* Jeden Vektor einzeln herauskopieren */
+  x = malloc ((A->m > 0 ? A->m : 1) * sizeof (*x));
+  y = malloc ((A->n > 0 ? A->n : 1) * sizeof (*y));
+  if (x == NULL || y == NULL) {
+    free (x);
+    free (y);
+    return F_KEIN_SPEICHER;
+  }
+  for (v = 0;v < nvek && fehler == F_ERFOLG;v++) {
+    for (i = 0;i < A->m;i++) x[i] = X[(long) i * nvek + v];
+    fehler = A->anwenden (y, x, A->daten);
+    for (i = 0;i < A->n;i++) Y[(long) i * nvek + v] = y[i];
+  }
+  free (x);
+  free (y);
+  return fehler;
+}
+
+Joelix_Fehler joelix_operator_loeschen (Joelix_Operator *pOperator)
+{
+  if (pOperator == NULL || *pOperator == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if ((*pOperator)->befreien != NULL) (*pOperator)->befreien ((*pOperator)->daten);
+  free (*pOperator);
+  *pOperator = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
@@ -0,0 +1,474 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+/* Fuer clock_gettime */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "joelix_error.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "optimieren.h"
+
+/* Ein Kernel berechnet b_i = (Mx)_i fuer die Zeilen anfang <= i < ende */
+typedef void (*joelix_spmv_funktion) (const struct Joelix_sparse_Matrix_t *M,
+                                      const double *x, double *b, int anfang, int ende);
+
+/* Die einfache CSR Schleife wie in joelix_smatvec */
+static void joelix_spmv_csr (const struct Joelix_sparse_Matrix_t *M,
+                             const double *x, double *b, int anfang, int ende)
+{
+  int i, k;
+  double summe;
+
+  for (i = anfang;i < ende;i++) {
+    summe = 0;
+    for (k = M->zeilen_akk[i];k < M->zeilen_akk[i+1];k++) {
+      summe += M->werte[k] * x[M->spalten_ind[k]];
+    }
+    b[i] = summe;
+  }
+}
+
+/* CSR mit vier unabhaengigen Teilsummen, damit die Additionen nicht
+   aufeinander warten muessen */
+static void joelix_spmv_csr_unroll (const struct Joelix_sparse_Matrix_t *M,
+                                    const double *x, double *b, int anfang, int ende)
+{
+  int i, k, kende;
+  double s0, s1, s2, s3;
+  const double *w = M->werte;
+  const int *s = M->spalten_ind;
+
+  for (i = anfang;i < ende;i++) {
+    s0 = s1 = s2 = s3 = 0;
+    kende = M->zeilen_akk[i+1];
+    for (k = M->zeilen_akk[i];k + 4 <= kende;k += 4) {
+      s0 += w[k] * x[s[k]];
+      s1 += w[k+1] * x[s[k+1]];
+      s2 += w[k+2] * x[s[k+2]];
+      s3 += w[k+3] * x[s[k+3]];
+    }
+    for (;k < kende;k++) s0 += w[k] * x[s[k]];
+    b[i] = (s0 + s1) + (s2 + s3);
+  }
+}
+
+/* CSR, bei dem jeweils 8 Eintraege von x in einen zusammenhaengenden Puffer
+   gesammelt werden. Das Produkt mit den Werten ist dann eine einfache
+   Schleife ohne indirekten Zugriff, die der Compiler vektorisieren kann. */
+#define JOELIX_GATHER_BREITE 8
+static void joelix_spmv_csr_gather (const struct Joelix_sparse_Matrix_t *M,
+                                    const double *x, double *b, int anfang, int ende)
+{
+  int i, k, l, kende;
+  double puffer[JOELIX_GATHER_BREITE], summen[JOELIX_GATHER_BREITE], summe;
+  const double *w = M->werte;
+  const int *s = M->spalten_ind;
+
+  for (i = anfang;i < ende;i++) {
+    for (l = 0;l < JOELIX_GATHER_BREITE;l++) summen[l] = 0;
+    kende = M->zeilen_akk[i+1];
+    for (k = M->zeilen_akk[i];k + JOELIX_GATHER_BREITE <= kende;k += JOELIX_GATHER_BREITE) {
+      for (l = 0;l < JOELIX_GATHER_BREITE;l++) puffer[l] = x[s[k+l]];
+      for (l = 0;l < JOELIX_GATHER_BREITE;l++) summen[l] += w[k+l] * puffer[l];
+    }
+    summe = 0;
+    for (l = 0;l < JOELIX_GATHER_BREITE;l++) summe += summen[l];
+    for (;k < kende;k++) summe += w[k] * x[s[k]];
+    b[i] = summe;
+  }
+}
+
+/* ELLPACK: Die innere Schleife laeuft ueber aufeinanderfolgende Zeilen und
+   ist damit vektorisierbar. */
+static void joelix_spmv_ell (const struct Joelix_sparse_Matrix_t *M,
+                             const double *x, double *b, int anfang, int ende)
+{
+  int i, j;
+  long versatz;
+
+  for (i = anfang;i < ende;i++) b[i] = 0;
+  for (j = 0;j < M->ell_breite;j++) {
+    versatz = (long) j * M->n;
+    for (i = anfang;i < ende;i++) {
+      b[i] += M->ell_werte[versatz + i] * x[M->ell_spalten[versatz + i]];
+    }
+  }
+}
+
+/* Die Kernel in der Reihenfolge von Joelix_SpMV_Kernel */
+static const joelix_spmv_funktion joelix_spmv_kernel[JOELIX_SPMV_ANZAHL] = {
+  joelix_spmv_csr,
+  joelix_spmv_csr_unroll,
+  joelix_spmv_csr_gather,
+  joelix_spmv_ell
+};
+
+/* Die Argumente fuer das parallele Produkt */
+struct joelix_spmv_aufgabe
+{
+  struct Joelix_sparse_Matrix_t * M;
+  const double * x;
+  double * b;
+};
+
+static void joelix_spmv_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_spmv_aufgabe *a = daten;
+  struct Joelix_sparse_Matrix_t *M = a->M;
+
+  (void) nthreads;
+  /* Threads, die nicht zu M->threads gehoeren, haben nichts zu tun */
+  if (tid >= M->threads) return;
+  joelix_spmv_kernel[M->kernel] (M, a->x, a->b, M->grenzen[tid], M->grenzen[tid+1]);
+}
+
+/* b = Mx mit dem ausgewaehlten Kernel */
+Joelix_Fehler joelix_smatvec_optimiert (double * b, struct Joelix_sparse_Matrix_t * M,
+                                        const double * x)
+{
+  struct joelix_spmv_aufgabe a;
+
+  if (M->threads > 1) {
+    a.M = M;
+    a.x = x;
+    a.b = b;
+    return joelix_kontext_ausfuehren (M->kontext, joelix_spmv_aufgabe, &a);
+  }
+  joelix_spmv_kernel[M->kernel] (M, x, b, 0, M->n);
+  return F_ERFOLG;
+}
+
+/* Zurueck zum einfachen Kernel */
+void joelix_smatrix_kernel_zuruecksetzen (struct Joelix_sparse_Matrix_t * M)
+{
+  free (M->grenzen);
+  free (M->ell_werte);
+  free (M->ell_spalten);
+  M->grenzen = NULL;
+  M->ell_werte = NULL;
+  M->ell_spalten = NULL;
+  M->ell_breite = 0;
+  M->kernel = JOELIX_SPMV_CSR;
+  M->threads = 1;
+  M->kontext = NULL;
+}
+
+/* Laenge der laengsten Zeile */
+static int joelix_smatrix_max_zeile (Joelix_sMatrix M)
+{
+  int i, laenge = 0;
+
+  for (i = 0;i < M->n;i++) {
+    if (M->zeilen_akk[i+1] - M->zeilen_akk[i] > laenge) laenge = M->zeilen_akk[i+1] - M->zeilen_akk[i];
+  }
+  return laenge;
+}
+
+/* Erstellt die ELLPACK Kopie der Matrix */
+static Joelix_Fehler joelix_smatrix_ell_aufbauen (Joelix_sMatrix M)
+{
+  int i, j, k;
+  long groesse, versatz;
+
+  M->ell_breite = joelix_smatrix_max_zeile (M);
+  groesse = (long) M->ell_breite * M->n;
+  M->ell_werte = malloc ((groesse > 0 ? groesse : 1) * sizeof (*M->ell_werte));
+  M->ell_spalten = malloc ((groesse > 0 ? groesse : 1) * sizeof (*M->ell_spalten));
+  if (M->ell_werte == NULL || M->ell_spalten == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  for (i = 0;i < M->n;i++) {
+    for (j = 0, k = M->zeilen_akk[i];j < M->ell_breite;j++, k++) {
+      versatz = (long) j * M->n + i;
+      if (k < M->zeilen_akk[i+1]) {
+        M->ell_werte[versatz] = M->werte[k];
+        M->ell_spalten[versatz] = M->spalten_ind[k];
+      }
+      else {
+        /* Auffuellen mit einer 0 in einer gueltigen Spalte */
+        M->ell_werte[versatz] = 0;
+        M->ell_spalten[versatz] = 0;
+      }
+    }
+  }
+  return F_ERFOLG;
+}
+
+/* Setze den Kernel direkt */
+Joelix_Fehler joelix_smatrix_setze_kernel (Joelix_sMatrix M, Joelix_SpMV_Kernel kernel,
+                                           Joelix_Kontext K, int threads)
+{
+  int t, i;
+
+  if (M == NULL || (int) kernel < 0 || kernel >= JOELIX_SPMV_ANZAHL || threads < 1
+      || (K == NULL && threads > 1) || (K != NULL && threads > K->nthreads)) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  joelix_smatrix_kernel_zuruecksetzen (M);
+  if (kernel == JOELIX_SPMV_ELL && joelix_smatrix_ell_aufbauen (M) != F_ERFOLG) {
+    joelix_smatrix_kernel_zuruecksetzen (M);
+    return joelix_fehler_code;
+  }
+  if (threads > 1) {
+    M->grenzen = malloc ((threads + 1) * sizeof (*M->grenzen));
+    if (M->grenzen == NULL) {
+      joelix_smatrix_kernel_zuruecksetzen (M);
+      return (joelix_fehler_code = F_KEIN_SPEICHER);
+    }
+    /* Thread t beginnt mit der ersten Zeile, vor der mindestens
+       nnE*t/threads Eintraege liegen */
+    i = 0;
+    for (t = 0;t < threads;t++) {
+      while (i < M->n && M->zeilen_akk[i] < (long) M->nnE * t / threads) i++;
+      M->grenzen[t] = i;
+    }
+    M->grenzen[threads] = M->n;
+    M->kontext = K;
+  }
+  M->kernel = kernel;
+  M->threads = threads;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Der Kernel von M */
+int joelix_smatrix_kernel (Joelix_sMatrix M)
+{
+  if (M == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return M->kernel;
+}
+
+/* Die Threads von M */
+int joelix_smatrix_kernel_threads (Joelix_sMatrix M)
+{
+  if (M == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return M->threads;
+}
+
+/* Die Merkmale einer Matrix, unter denen eine Entscheidung gespeichert wird.
+   Groessen werden logarithmisch gerundet, damit aehnliche Matrizen die
+   gleiche Entscheidung benutzen. */
+#define JOELIX_MERKMALE 6
+struct joelix_merkmale
+{
+  int m[JOELIX_MERKMALE]; /* log2(n), log2(nnE), mittlere Zeilenlaenge,
+                             log2(maximale Zeilenlaenge), 10 * Variations-
+                             koeffizient der Zeilenlaenge, Threads von K */
+};
+
+static int joelix_log2 (long x)
+{
+  int l = 0;
+
+  while (x > 1) {
+    x /= 2;
+    l++;
+  }
+  return l;
+}
+
+static void joelix_smatrix_merkmale (Joelix_sMatrix M, Joelix_Kontext K,
+                                     struct joelix_merkmale *merkmale)
+{
+  int i, laenge;
+  double mittel, varianz = 0;
+
+  mittel = M->n > 0 ? (double) M->nnE / M->n : 0;
+  for (i = 0;i < M->n;i++) {
+    laenge = M->zeilen_akk[i+1] - M->zeilen_akk[i];
+    varianz += (laenge - mittel) * (laenge - mittel);
+  }
+  if (M->n > 0) varianz /= M->n;
+  merkmale->m[0] = joelix_log2 (M->n);
+  merkmale->m[1] = joelix_log2 (M->nnE);
+  merkmale->m[2] = (int) (mittel + 0.5);
+  merkmale->m[3] = joelix_log2 (joelix_smatrix_max_zeile (M));
+  merkmale->m[4] = mittel > 0 ? (int) (10 * sqrt (varianz) / mittel + 0.5) : 0;
+  merkmale->m[5] = K != NULL ? K->nthreads : 1;
+}
+
+/* Suche die Merkmale in der Datei. Gibt 1 zurueck, wenn sie gefunden wurden. */
+static int joelix_tuning_lesen (const char *dateiname, const struct joelix_merkmale *merkmale,
+                                int *kernel, int *threads)
+{
+  FILE *file;
+  char zeile[256];
+  int werte[JOELIX_MERKMALE + 2];
+  int i, gefunden = 0;
+
+  if (dateiname == NULL) return 0;
+  file = fopen (dateiname, "r");
+  if (file == NULL) return 0;
+  while (!gefunden && fgets (zeile, sizeof (zeile), file) != NULL) {
+    if (zeile[0] == '#') continue;
+    if (sscanf (zeile, "%i %i %i %i %i %i %i %i", &werte[0], &werte[1], &werte[2], &werte[3],
+                &werte[4], &werte[5], &werte[6], &werte[7]) != JOELIX_MERKMALE + 2) continue;
+    gefunden = 1;
+    for (i = 0;i < JOELIX_MERKMALE;i++) {
+      if (werte[i] != merkmale->m[i]) gefunden = 0;
+    }
+    if (gefunden) {
+      *kernel = werte[JOELIX_MERKMALE];
+      *threads = werte[JOELIX_MERKMALE + 1];
+    }
+  }
+  fclose (file);
+  return gefunden;
+}
+
+/* Haenge eine Entscheidung an die Datei an */
+static Joelix_Fehler joelix_tuning_schreiben (const char *dateiname,
+                                              const struct joelix_merkmale *merkmale,
+                                              int kernel, int threads)
+{
+  FILE *file;
+  int i, neu;
+
+  if (dateiname == NULL) return F_ERFOLG;
+  file = fopen (dateiname, "r");
+  neu = (file == NULL);
+  if (file != NULL) fclose (file);
+  file = fopen (dateiname, "a");
+  if (file == NULL) return (joelix_fehler_code = F_FILEIO_FEHLER);
+  if (neu) {
+    fprintf (file, "# joelixblas SpMV Entscheidungen\n"
+             "# log2(n) log2(nnE) mittel log2(max) 10*variation threads_kontext"
+             " kernel threads\n");
+  }
+  for (i = 0;i < JOELIX_MERKMALE;i++) fprintf (file, "%i ", merkmale->m[i]);
+  if (fprintf (file, "%i %i\n", kernel, threads) <= 0) {
+    fclose (file);
+    return (joelix_fehler_code = F_FILEIO_FEHLER);
+  }
+  fclose (file);
+  return F_ERFOLG;
+}
+
+/* Aktuelle Zeit in Sekunden */
+static double joelix_zeit (void)
+{
+  struct timespec t;
+
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/* Miss die Zeit fuer ein Produkt mit dem aktuellen Kernel von M. Es wird
+   mindestens dreimal und hoechstens 50 mal gemessen, bis insgesamt 20ms
+   vergangen sind, und die kuerzeste Zeit zurueckgegeben. Schlaegt ein
+   Produkt fehl, wird -1 zurueckgegeben. */
+static double joelix_smatvec_messen (Joelix_sMatrix M, const double *x, double *b)
+{
+  double anfang, dauer, beste = -1, gesamt = 0;
+  int i;
+
+  if (joelix_smatvec_optimiert (b, M, x) != F_ERFOLG) return -1;
+  for (i = 0;i < 50 && (i < 3 || gesamt < 0.02);i++) {
+    anfang = joelix_zeit ();
+    if (joelix_smatvec_optimiert (b, M, x) != F_ERFOLG) return -1;
+    dauer = joelix_zeit () - anfang;
+    gesamt += dauer;
+    if (beste < 0 || dauer < beste) beste = dauer;
+  }
+  return beste;
+}
+
+/* Waehle den besten Kernel fuer M */
+Joelix_Fehler joelix_smatrix_optimieren (Joelix_sMatrix M, Joelix_Kontext K,
+                                         const char *dateiname)
+{
+  struct joelix_merkmale merkmale;
+  int kernel, threads, beste_kernel, beste_threads, nthreads, ell_erlaubt;
+  double *x, *b, zeit, beste_zeit = -1;
+  int i;
+
+  if (M == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (!joelix_smatrix_ist_befuellt (M)) return (joelix_fehler_code = F_FALSCHE_ANZAHL_NICHT_NULL_WERTE);
+  nthreads = K != NULL ? K->nthreads : 1;
+  joelix_smatrix_merkmale (M, K, &merkmale);
+
+  /* Gibt es schon eine Entscheidung? */
+  if (joelix_tuning_lesen (dateiname, &merkmale, &kernel, &threads)
+      && kernel >= 0 && kernel < JOELIX_SPMV_ANZAHL && threads >= 1 && threads <= nthreads) {
+    return joelix_smatrix_setze_kernel (M, kernel, threads > 1 ? K : NULL, threads);
+  }
+
+  x = malloc ((M->m > 0 ? M->m : 1) * sizeof (*x));
+  b = malloc ((M->n > 0 ? M->n : 1) * sizeof (*b));
+  if (x == NULL || b == NULL) {
+    free (x);
+    free (b);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  for (i = 0;i < M->m;i++) x[i] = 1;
+
+  /* ELLPACK lohnt sich nur, wenn hoechstens ein Viertel aufgefuellt wird */
+  ell_erlaubt = (long) joelix_smatrix_max_zeile (M) * M->n * 4 <= (long) M->nnE * 5;
+  beste_kernel = JOELIX_SPMV_CSR;
+  beste_threads = 1;
+  for (kernel = 0;kernel < JOELIX_SPMV_ANZAHL;kernel++) {
+    if (kernel == JOELIX_SPMV_ELL && !ell_erlaubt) continue;
+    /* Threadanzahlen 1, 2, 4, ... und die volle Anzahl */
+    threads = 1;
+    for (;;) {
+      if (joelix_smatrix_setze_kernel (M, kernel, threads > 1 ? K : NULL, threads) == F_ERFOLG) {
+        zeit = joelix_smatvec_messen (M, x, b);
+        /* Ein fehlgeschlagener Kandidat darf nicht gewinnen */
+        if (zeit >= 0 && (beste_zeit < 0 || zeit < beste_zeit)) {
+          beste_zeit = zeit;
+          beste_kernel = kernel;
+          beste_threads = threads;
+        }
+      }
+      if (threads == nthreads) break;
+      threads = 2 * threads < nthreads ? 2 * threads : nthreads;
+    }
+  }
+  free (x);
+  free (b);
+
+  if (joelix_smatrix_setze_kernel (M, beste_kernel, beste_threads > 1 ? K : NULL,
+                                   beste_threads) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  /* Ohne eine gelungene Messung wird nichts gespeichert */
+  if (beste_zeit >= 0
+      && joelix_tuning_schreiben (dateiname, &merkmale, beste_kernel,
+                                  beste_threads) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
@@ -0,0 +1,187 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "svektor_hidden.h"
+#include "svektor.h"
+
+/* Einen sparse Vektor erstellen */
+Joelix_Fehler joelix_svektor_init (Joelix_sVektor *pVektor, int n, int kapazitaet)
+{
+  Joelix_sVektor x;
+
+  if (pVektor == NULL || n < 0 || kapazitaet < 0) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (kapazitaet < 1) kapazitaet = 1;
+  x = malloc (sizeof (*x));
+  if (x == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  x->indices = malloc (kapazitaet * sizeof (*x->indices));
+  x->werte = malloc (kapazitaet * sizeof (*x->werte));
+  if (x->indices == NULL || x->werte == NULL) {
+    free (x->indices);
+    free (x->werte);
+    free (x);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  x->laenge = n;
+  x->nnE = 0;
+  x->kapazitaet = kapazitaet;
+  *pVektor = x;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_svektor_null (Joelix_sVektor x)
+{
+  if (x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  x->nnE = 0;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Platz fuer einen weiteren Eintrag schaffen, die Kapazitaet wird dabei
+   verdoppelt */
+static Joelix_Fehler joelix_svektor_wachsen (Joelix_sVektor x)
+{
+  int *indices;
+  double *werte;
+  int kapazitaet;
+
+  if (x->nnE < x->kapazitaet) return F_ERFOLG;
+  kapazitaet = 2 * x->kapazitaet;
+  indices = realloc (x->indices, kapazitaet * sizeof (*indices));
+  if (indices == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  x->indices = indices;
+  werte = realloc (x->werte, kapazitaet * sizeof (*werte));
+  if (werte == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  x->werte = werte;
+  x->kapazitaet = kapazitaet;
+  return F_ERFOLG;
+}
+
+Joelix_Fehler joelix_svektor_hinzufuegen (Joelix_sVektor x, int i, double wert)
+{
+  if (x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (i < 0 || i >= x->laenge) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  if (joelix_svektor_wachsen (x) != F_ERFOLG) return joelix_fehler_code;
+  x->indices[x->nnE] = i;
+  x->werte[x->nnE] = wert;
+  x->nnE++;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* dx = xneu - xalt an den Stellen, an denen sich xneu und xalt unterscheiden */
+Joelix_Fehler joelix_svektor_differenz (Joelix_sVektor dx, Joelix_Vektor xneu,
+                                        Joelix_Vektor xalt)
+{
+  int i;
+
+  if (dx == NULL || xneu == NULL || xalt == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (xneu->laenge != dx->laenge || xalt->laenge != dx->laenge) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+  }
+  dx->nnE = 0;
+  for (i = 0;i < dx->laenge;i++) {
+    if (xneu->werte[i] == xalt->werte[i]) continue;
+    if (joelix_svektor_wachsen (dx) != F_ERFOLG) return joelix_fehler_code;
+    dx->indices[dx->nnE] = i;
+    dx->werte[dx->nnE] = xneu->werte[i] - xalt->werte[i];
+    dx->nnE++;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+int joelix_svektor_laenge (Joelix_sVektor x)
+{
+  if (x == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return x->laenge;
+}
+
+int joelix_svektor_anzahl (Joelix_sVektor x)
+{
+  if (x == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return x->nnE;
+}
+
+Joelix_Fehler joelix_svektor_eintrag (Joelix_sVektor x, int k, int *i, double *wert)
+{
+  if (x == NULL || i == NULL || wert == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (k < 0 || k >= x->nnE) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  *i = x->indices[k];
+  *wert = x->werte[k];
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* y = y + alpha x */
+Joelix_Fehler joelix_vektor_saxpy (Joelix_Vektor y, Joelix_sVektor x, double alpha)
+{
+  int k;
+
+  if (y == NULL || x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (y->laenge != x->laenge) return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+  for (k = 0;k < x->nnE;k++) y->werte[x->indices[k]] += alpha * x->werte[k];
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* b = b + M dx, spaltenweise */
+Joelix_Fehler joelix_smatvec_delta (Joelix_Vektor b, Joelix_sMatrix M, Joelix_sVektor dx)
+{
+  int k, p, j;
+  double d;
+  const int *akk, *zeilen, *stelle;
+
+  if (b == NULL || M == NULL || dx == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (b->laenge != M->n || dx->laenge != M->m) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR);
+  }
+  if (joelix_smatrix_spalten_aufbauen (M) != F_ERFOLG) return joelix_fehler_code;
+  akk = M->csc_akk;
+  zeilen = M->csc_zeilen;
+  stelle = M->csc_stelle;
+  for (k = 0;k < dx->nnE;k++) {
+    j = dx->indices[k];
+    d = dx->werte[k];
+    for (p = akk[j];p < akk[j+1];p++) b->werte[zeilen[p]] += M->werte[stelle[p]] * d;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+Joelix_Fehler joelix_svektor_loeschen (Joelix_sVektor *pVektor)
+{
+  if (pVektor == NULL || *pVektor == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  free ((*pVektor)->indices);
+  free ((*pVektor)->werte);
+  free (*pVektor);
+  *pVektor = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
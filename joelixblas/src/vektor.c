@@ -25,8 +25,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <sys/mman.h>
 #include "vektor_hidden.h"
 #include "vektor.h"
+#include "kontext_hidden.h"
+#include "kontext.h"
 #include "joelix_error.h"
 
 extern Joelix_Fehler joelix_fehler_code;
@@ -54,6 +58,8 @@ Joelix_Fehler joelix_vektor_init (Joelix_Vektor * px, int n)
     return (joelix_fehler_code = F_KEIN_SPEICHER);
   }
   V->laenge = n;
+  V->abbildung = NULL;
+  V->abbildung_laenge = 0;
   *px = V;
   return (joelix_fehler_code = F_ERFOLG);
 }
@@ -165,6 +171,14 @@ Joelix_Fehler joelix_vektor_dot (double * produkt, Joelix_Vektor x, Joelix_Vekto
   return (joelix_fehler_code = F_ERFOLG);  
 }
 
+/* Berechne die 2-Norm von x */
+Joelix_Fehler joelix_vektor_norm (double * norm, Joelix_Vektor x)
+{
+  if (joelix_vektor_dot (norm, x, x) != F_ERFOLG) return joelix_fehler_code;
+  *norm = sqrt (*norm);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
 Joelix_Fehler joelix_vektor_print (Joelix_Vektor x)
 {
   int i;
@@ -179,21 +193,276 @@ Joelix_Fehler joelix_vektor_print (Joelix_Vektor x)
 
 Joelix_Fehler joelix_vektor_print_tofile (Joelix_Vektor x, char *filename)
 {
-  FILE * file;
-  int i, ret;
+  if (x == NULL || filename == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  /* schreibe Eintraege des Vektors gepuffert Zeile fuer Zeile ins File */
+  return joelix_vektor_text_ausgeben (x, filename, 1);
+}
 
-  file = fopen (filename, "w");
-  if (file == NULL) return F_FALSCHE_PARAMETER;
-  /* schreibe Eintraege des Vektors Zeile fuer Zeile ins File */
-  for (i = 0;i < x->laenge;i++) {
-    ret = fprintf (file, "%e %e\n", ((double) i) / (x->laenge - 1), x->werte[i]);
-    if (ret <= 0) {
-      fclose (file);
-      return F_FILEIO_FEHLER;
-    }
+/* Die Argumente der parallelen Vektoroperationen */
+struct joelix_vektor_aufgabe
+{
+  double * x;
+  double * y;
+  int n;
+  double alpha;
+  double * teilsummen;
+};
+
+/* Setzt den eigenen Bereich von x auf 0. Wird auch fuer das first touch
+   beim Initialisieren benutzt. */
+static void joelix_vektor_null_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int anfang, ende;
+
+  joelix_kontext_bereich (a->n, tid, nthreads, &anfang, &ende);
+  if (ende > anfang) memset (a->x + anfang, 0, (ende - anfang) * sizeof (*a->x));
+}
+
+static void joelix_vektor_copy_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int anfang, ende;
+
+  joelix_kontext_bereich (a->n, tid, nthreads, &anfang, &ende);
+  if (ende > anfang) memcpy (a->y + anfang, a->x + anfang, (ende - anfang) * sizeof (*a->x));
+}
+
+static void joelix_vektor_ax_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int i, anfang, ende;
+
+  joelix_kontext_bereich (a->n, tid, nthreads, &anfang, &ende);
+  for (i = anfang;i < ende;i++) a->x[i] *= a->alpha;
+}
+
+static void joelix_vektor_axpy_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int i, anfang, ende;
+
+  joelix_kontext_bereich (a->n, tid, nthreads, &anfang, &ende);
+  for (i = anfang;i < ende;i++) a->y[i] += a->alpha * a->x[i];
+}
+
+static void joelix_vektor_dot_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int i, anfang, ende;
+  double summe = 0;
+
+  joelix_kontext_bereich (a->n, tid, nthreads, &anfang, &ende);
+  for (i = anfang;i < ende;i++) summe += a->x[i] * a->y[i];
+  a->teilsummen[tid * JOELIX_KONTEXT_TEILSUMMEN_ABSTAND] = summe;
+}
+
+/* Die Summe von x[i]*y[i] fuer anfang <= i < ende. Mit vier festen
+   Teilsummen, damit die Schleife nicht an der Latenz der Addition haengt,
+   aber immer in derselben Reihenfolge. */
+static double joelix_block_summe (const double *x, const double *y, int anfang, int ende)
+{
+  double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  int i;
+
+  for (i = anfang;i + 3 < ende;i += 4) {
+    s0 += x[i] * y[i];
+    s1 += x[i+1] * y[i+1];
+    s2 += x[i+2] * y[i+2];
+    s3 += x[i+3] * y[i+3];
+  }
+  for (;i < ende;i++) s0 += x[i] * y[i];
+  return (s0 + s1) + (s2 + s3);
+}
+
+/* Jeder Thread berechnet die Summen seiner Bloecke. Die Aufteilung der
+   Bloecke auf die Threads aendert keine Blocksumme. */
+static void joelix_vektor_dot_block_aufgabe (void *daten, int tid, int nthreads)
+{
+  struct joelix_vektor_aufgabe *a = daten;
+  int b, anfang, ende, nblock, ende_b;
+
+  nblock = (a->n + JOELIX_KONTEXT_BLOCK - 1) / JOELIX_KONTEXT_BLOCK;
+  joelix_kontext_bereich (nblock, tid, nthreads, &anfang, &ende);
+  for (b = anfang;b < ende;b++) {
+    ende_b = (b + 1) * JOELIX_KONTEXT_BLOCK;
+    if (ende_b > a->n) ende_b = a->n;
+    a->teilsummen[b] = joelix_block_summe (a->x, a->y, b * JOELIX_KONTEXT_BLOCK, ende_b);
   }
-  fclose (file);
-  return F_ERFOLG;
+}
+
+/* Reproduzierbares Skalarprodukt: Blocksummen fester Laenge, die danach
+   paarweise in einem Baum addiert werden, der nur von der Anzahl der
+   Bloecke abhaengt */
+static Joelix_Fehler joelix_vektor_dot_reproduzierbar (double * produkt, double * x, double * y,
+                                                       int n, Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+  double *bloecke;
+  int nblock, b, schritt;
+
+  nblock = (n + JOELIX_KONTEXT_BLOCK - 1) / JOELIX_KONTEXT_BLOCK;
+  if (nblock > K->bloecke_kapazitaet) {
+    bloecke = realloc (K->bloecke, nblock * sizeof (*bloecke));
+    if (bloecke == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+    K->bloecke = bloecke;
+    K->bloecke_kapazitaet = nblock;
+  }
+  a.x = x;
+  a.y = y;
+  a.n = n;
+  a.teilsummen = K->bloecke;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_dot_block_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  for (schritt = 1;schritt < nblock;schritt *= 2) {
+    for (b = 0;b + schritt < nblock;b += 2 * schritt) K->bloecke[b] += K->bloecke[b + schritt];
+  }
+  *produkt = (nblock > 0 ? K->bloecke[0] : 0);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Einen Vektor mit first touch durch die Threads von K erstellen */
+Joelix_Fehler joelix_vektor_init_kontext (Joelix_Vektor * px, int n, Joelix_Kontext K)
+{
+  Joelix_Vektor V;
+  struct joelix_vektor_aufgabe a;
+
+  if (px == NULL || n < 0 || K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  V = malloc (sizeof (*V));
+  if (V == NULL) return (joelix_fehler_code = F_KEIN_SPEICHER);
+  /* Kein calloc: Die Seiten sollen erst von den Threads beschrieben werden */
+  V->werte = malloc ((n > 0 ? n : 1) * sizeof (*V->werte));
+  if (V->werte == NULL) {
+    free (V);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  V->laenge = n;
+  V->abbildung = NULL;
+  V->abbildung_laenge = 0;
+  a.x = V->werte;
+  a.n = n;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_null_aufgabe, &a) != F_ERFOLG) {
+    free (V->werte);
+    free (V);
+    return joelix_fehler_code;
+  }
+  *px = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* setze x = 0 parallel */
+Joelix_Fehler joelix_vektor_null_kontext (Joelix_Vektor x, Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+
+  if (x == NULL || K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  a.x = x->werte;
+  a.n = x->laenge;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_null_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* setze y = x parallel */
+Joelix_Fehler joelix_vektor_copy_kontext (Joelix_Vektor y, Joelix_Vektor x, Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+
+  if (x == NULL || y == NULL || K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (x->laenge != y->laenge) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_KOPIE);
+  }
+  a.x = x->werte;
+  a.y = y->werte;
+  a.n = x->laenge;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_copy_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Berechne x = alpha * x parallel */
+Joelix_Fehler joelix_vektor_ax_kontext (Joelix_Vektor x, double alpha, Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+
+  if (x == NULL || K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  a.x = x->werte;
+  a.n = x->laenge;
+  a.alpha = alpha;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_ax_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Berechne y = alpha * x + y parallel */
+Joelix_Fehler joelix_vektor_axpy_kontext (Joelix_Vektor y, Joelix_Vektor x, double alpha,
+                                          Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+
+  if (x == NULL || y == NULL || K == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (x->laenge != y->laenge) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+  }
+  a.x = x->werte;
+  a.y = y->werte;
+  a.n = x->laenge;
+  a.alpha = alpha;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_axpy_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Berechne das Skalarprodukt von x und y parallel */
+Joelix_Fehler joelix_vektor_dot_kontext (double * produkt, Joelix_Vektor x, Joelix_Vektor y,
+                                         Joelix_Kontext K)
+{
+  struct joelix_vektor_aufgabe a;
+  int t;
+
+  if (produkt == NULL || x == NULL || y == NULL || K == NULL) {
+    return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  }
+  if (x->laenge != y->laenge) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+  }
+  if (K->reproduzierbar) return joelix_vektor_dot_reproduzierbar (produkt, x->werte, y->werte,
+                                                                  x->laenge, K);
+  a.x = x->werte;
+  a.y = y->werte;
+  a.n = x->laenge;
+  a.teilsummen = K->teilsummen;
+  if (joelix_kontext_ausfuehren (K, joelix_vektor_dot_aufgabe, &a) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  /* Addiere die Teilsummen in fester Reihenfolge */
+  *produkt = 0;
+  for (t = 0;t < K->nthreads;t++) *produkt += K->teilsummen[t * JOELIX_KONTEXT_TEILSUMMEN_ABSTAND];
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Berechne die 2-Norm von x parallel */
+Joelix_Fehler joelix_vektor_norm_kontext (double * norm, Joelix_Vektor x, Joelix_Kontext K)
+{
+  if (joelix_vektor_dot_kontext (norm, x, x, K) != F_ERFOLG) return joelix_fehler_code;
+  *norm = sqrt (*norm);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Auf welchen Knoten liegt x? */
+Joelix_Fehler joelix_vektor_platzierung (Joelix_Vektor x, int *seiten, int nknoten)
+{
+  int k;
+
+  if (x == NULL || seiten == NULL || nknoten < 1) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  for (k = 0;k < nknoten;k++) seiten[k] = 0;
+  return joelix_kontext_seiten_platzierung (x->werte, x->laenge * sizeof (*x->werte),
+                                            seiten, nknoten);
 }
 
 /* Speicher eine Vektors freigeben */
@@ -207,7 +476,11 @@ Joelix_Fehler joelix_vektor_loeschen (Joelix_Vektor *pVektor)
   }
   /* Speicher freigeben und pVektor auf NULL setzen */
   V = *pVektor;
-  free (V->werte);
+  if (V->abbildung != NULL) {
+    munmap (V->abbildung, V->abbildung_laenge);
+  } else {
+    free (V->werte);
+  }
   free (V);
   pVektor = NULL;
   return (joelix_fehler_code = F_ERFOLG);
@@ -0,0 +1,551 @@
+/*  
+  This file is part of joelixblas.
+  joelixblas is a C library for some basic linear algebra routines, which
+  was created as supplementary material to the advanced C programming course
+  given by the authors in April 2017 at the univerity of Bonn.
+ 
+  Copyright (C) 2017 the developers
+ 
+  joelixblas is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+ 
+  joelixblas is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+ 
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software Foundation,
+  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <mpi.h>
+#include "joelix_error.h"
+#include "vektor_hidden.h"
+#include "vektor.h"
+#include "matrix_hidden.h"
+#include "matrix.h"
+#include "verteilt_hidden.h"
+#include "verteilt.h"
+
+/* Vergleichsfunktion fuer qsort und bsearch auf int */
+static int joelix_vergleiche_int (const void *a, const void *b)
+{
+  int x = *(const int *) a, y = *(const int *) b;
+  return (x > y) - (x < y);
+}
+
+/* Einigt sich mit allen Raengen von comm auf einen Fehlercode. Jeder Rang
+   ruft das vor einer kollektiven Operation auf, damit nicht ein Rang
+   aussteigt, waehrend die anderen in der kollektiven Operation auf ihn
+   warten. */
+static Joelix_Fehler joelix_gemeinsamer_fehler (MPI_Comm comm, Joelix_Fehler lokal)
+{
+  int l = (int) lokal, g;
+
+  if (MPI_Allreduce (&l, &g, 1, MPI_INT, MPI_MAX, comm) != MPI_SUCCESS) return F_MPI_FEHLER;
+  return (Joelix_Fehler) g;
+}
+
+/* Berechne die Aufteilung: Gibt in *nlokal die lokale Anzahl und in
+   anfaenge (Laenge nraenge+1) die Anfaenge aller Raenge zurueck. */
+static Joelix_Fehler joelix_verteilung (MPI_Comm comm, int n, int *nlokal, int *anfaenge)
+{
+  int rang, nraenge, r;
+
+  MPI_Comm_rank (comm, &rang);
+  MPI_Comm_size (comm, &nraenge);
+  if (*nlokal < 0) {
+    *nlokal = (int) ((long) n * (rang + 1) / nraenge - (long) n * rang / nraenge);
+  }
+  if (MPI_Allgather (nlokal, 1, MPI_INT, anfaenge + 1, 1, MPI_INT, comm) != MPI_SUCCESS) {
+    return (joelix_fehler_code = F_MPI_FEHLER);
+  }
+  anfaenge[0] = 0;
+  for (r = 0;r < nraenge;r++) anfaenge[r+1] += anfaenge[r];
+  /* Die lokalen Teile muessen zusammen genau n ergeben */
+  if (anfaenge[nraenge] != n) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  return F_ERFOLG;
+}
+
+/* Einen verteilten Vektor erstellen */
+Joelix_Fehler joelix_vvektor_init (Joelix_vVektor *pVektor, MPI_Comm comm, int n, int nlokal)
+{
+  Joelix_vVektor V;
+  Joelix_Fehler fehler = F_ERFOLG;
+  int *anfaenge;
+  int rang, nraenge;
+
+  MPI_Comm_rank (comm, &rang);
+  MPI_Comm_size (comm, &nraenge);
+  anfaenge = malloc ((nraenge + 1) * sizeof (*anfaenge));
+  if (pVektor == NULL || n < 0) fehler = F_FALSCHE_PARAMETER;
+  else if (anfaenge == NULL) fehler = F_KEIN_SPEICHER;
+  /* Vor dem MPI_Allgather in joelix_verteilung muessen alle Raenge
+     wissen, ob einer aussteigt */
+  fehler = joelix_gemeinsamer_fehler (comm, fehler);
+  if (fehler != F_ERFOLG) {
+    free (anfaenge);
+    return (joelix_fehler_code = fehler);
+  }
+  if (joelix_verteilung (comm, n, &nlokal, anfaenge) != F_ERFOLG) {
+    free (anfaenge);
+    return joelix_fehler_code;
+  }
+  V = malloc (sizeof (*V));
+  if (V == NULL) {
+    free (anfaenge);
+    return (joelix_fehler_code = F_KEIN_SPEICHER);
+  }
+  V->comm = comm;
+  V->n = n;
+  V->anfang = anfaenge[rang];
+  free (anfaenge);
+  if (joelix_vektor_init (&V->lokal, nlokal) != F_ERFOLG) {
+    free (V);
+    return joelix_fehler_code;
+  }
+  *pVektor = V;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Der lokale Teil */
+Joelix_Vektor joelix_vvektor_lokal (Joelix_vVektor x)
+{
+  if (x == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return NULL;
+  }
+  return x->lokal;
+}
+
+/* Globaler Index des ersten lokalen Eintrags */
+int joelix_vvektor_anfang (Joelix_vVektor x)
+{
+  if (x == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return x->anfang;
+}
+
+/* Skalarprodukt mit einer einzigen Reduktion */
+Joelix_Fehler joelix_vvektor_dot (double *produkt, Joelix_vVektor x, Joelix_vVektor y)
+{
+  double lokal;
+
+  if (produkt == NULL || x == NULL || y == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (x->n != y->n || x->anfang != y->anfang) {
+    return (joelix_fehler_code = F_FALSCHE_DIMENSIONEN_VEKTOR_VEKTOR);
+  }
+  if (joelix_vektor_dot (&lokal, x->lokal, y->lokal) != F_ERFOLG) return joelix_fehler_code;
+  if (MPI_Allreduce (&lokal, produkt, 1, MPI_DOUBLE, MPI_SUM, x->comm) != MPI_SUCCESS) {
+    return (joelix_fehler_code = F_MPI_FEHLER);
+  }
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Euklidische Norm mit einer einzigen Reduktion */
+Joelix_Fehler joelix_vvektor_norm (double *norm, Joelix_vVektor x)
+{
+  double lokal, global;
+
+  if (norm == NULL || x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (joelix_vektor_dot (&lokal, x->lokal, x->lokal) != F_ERFOLG) return joelix_fehler_code;
+  if (MPI_Allreduce (&lokal, &global, 1, MPI_DOUBLE, MPI_SUM, x->comm) != MPI_SUCCESS) {
+    return (joelix_fehler_code = F_MPI_FEHLER);
+  }
+  *norm = sqrt (global);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Speicher eines verteilten Vektors freigeben */
+Joelix_Fehler joelix_vvektor_loeschen (Joelix_vVektor *pVektor)
+{
+  if (pVektor == NULL || *pVektor == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_vektor_loeschen (&(*pVektor)->lokal);
+  free (*pVektor);
+  *pVektor = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Gebe Speicher einer verteilten Matrix frei */
+static void joelix_vsmatrix_befreien (Joelix_vsMatrix M)
+{
+  if (M == NULL) return;
+  if (M->global != NULL) joelix_smatrix_loeschen (&M->global);
+  if (M->diag != NULL) joelix_smatrix_loeschen (&M->diag);
+  if (M->offd != NULL) joelix_smatrix_loeschen (&M->offd);
+  free (M->anfaenge);
+  free (M->geist_global);
+  free (M->geist_werte);
+  free (M->empfang_rang);
+  free (M->empfang_anfang);
+  free (M->sende_rang);
+  free (M->sende_anfang);
+  free (M->sende_ind);
+  free (M->sende_werte);
+  free (M->anfragen);
+  free (M);
+}
+
+/* Initialisiere verteilte Matrix */
+Joelix_Fehler joelix_vsmatrix_init (Joelix_vsMatrix *pMatrix, MPI_Comm comm, int n, int nlokal,
+                                    int nnichtnull)
+{
+  Joelix_vsMatrix M;
+  Joelix_Fehler fehler = F_ERFOLG;
+
+  M = calloc (1, sizeof (*M));
+  if (M != NULL) {
+    M->comm = comm;
+    M->n = n;
+    MPI_Comm_rank (comm, &M->rang);
+    MPI_Comm_size (comm, &M->nraenge);
+    M->anfaenge = malloc ((M->nraenge + 1) * sizeof (*M->anfaenge));
+  }
+  if (pMatrix == NULL || n < 0 || nnichtnull < 0) fehler = F_FALSCHE_PARAMETER;
+  else if (M == NULL || M->anfaenge == NULL) fehler = F_KEIN_SPEICHER;
+  /* Wie in joelix_vvektor_init vor dem MPI_Allgather einigen */
+  fehler = joelix_gemeinsamer_fehler (comm, fehler);
+  if (fehler != F_ERFOLG) {
+    joelix_vsmatrix_befreien (M);
+    return (joelix_fehler_code = fehler);
+  }
+  if (joelix_verteilung (comm, n, &nlokal, M->anfaenge) != F_ERFOLG) {
+    joelix_vsmatrix_befreien (M);
+    return joelix_fehler_code;
+  }
+  M->nlokal = nlokal;
+  /* Die lokalen Zeilen werden zunaechst mit globalen Spaltenindices
+     gespeichert */
+  if (joelix_smatrix_init (&M->global, nlokal, n, nnichtnull) != F_ERFOLG) {
+    joelix_vsmatrix_befreien (M);
+    return joelix_fehler_code;
+  }
+  *pMatrix = M;
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Globaler Index der ersten lokalen Zeile */
+int joelix_vsmatrix_anfang (Joelix_vsMatrix M)
+{
+  if (M == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return M->anfaenge[M->rang];
+}
+
+/* Anzahl der lokalen Zeilen */
+int joelix_vsmatrix_lokale_zeilen (Joelix_vsMatrix M)
+{
+  if (M == NULL) {
+    joelix_fehler_code = F_FALSCHE_PARAMETER;
+    return -1;
+  }
+  return M->nlokal;
+}
+
+/* Befuelle eine lokale Zeile */
+Joelix_Fehler joelix_vsmatrix_fuelleZeile (Joelix_vsMatrix M, int zeile, int znichtnull,
+                                           double *werte, int *spalten)
+{
+  int anfang;
+
+  if (M == NULL || M->global == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  anfang = M->anfaenge[M->rang];
+  if (zeile < anfang || zeile >= anfang + M->nlokal) return (joelix_fehler_code = F_FALSCHER_INDEX);
+  return joelix_smatrix_fuelleZeile (M->global, zeile - anfang, znichtnull, werte, spalten);
+}
+
+/* Finde den Rang, der den globalen Index i besitzt (binaere Suche in anfaenge) */
+static int joelix_vsmatrix_besitzer (Joelix_vsMatrix M, int i)
+{
+  int links = 0, rechts = M->nraenge - 1, mitte;
+
+  while (links < rechts) {
+    mitte = (links + rechts + 1) / 2;
+    if (M->anfaenge[mitte] <= i) links = mitte;
+    else rechts = mitte - 1;
+  }
+  return links;
+}
+
+/* Verwirft alles, was joelix_vsmatrix_aufbauen angelegt hat. M->global
+   bleibt erhalten, die Matrix ist danach wieder im Zustand vor dem Aufbau. */
+static void joelix_vsmatrix_abbauen (Joelix_vsMatrix M)
+{
+  /* joelix_smatrix_loeschen setzt den Pointer nicht auf NULL */
+  if (M->diag != NULL) joelix_smatrix_loeschen (&M->diag);
+  if (M->offd != NULL) joelix_smatrix_loeschen (&M->offd);
+  M->diag = M->offd = NULL;
+  free (M->geist_global);
+  free (M->geist_werte);
+  free (M->empfang_rang);
+  free (M->empfang_anfang);
+  free (M->sende_rang);
+  free (M->sende_anfang);
+  free (M->sende_ind);
+  free (M->sende_werte);
+  free (M->anfragen);
+  M->geist_global = M->empfang_rang = M->empfang_anfang = NULL;
+  M->sende_rang = M->sende_anfang = M->sende_ind = NULL;
+  M->geist_werte = M->sende_werte = NULL;
+  M->anfragen = NULL;
+  M->ngeist = M->nempfang = M->nsende = 0;
+}
+
+/* Schritte 1 und 2 von joelix_vsmatrix_aufbauen, ohne Kommunikation */
+static Joelix_Fehler joelix_vsmatrix_lokal_aufbauen (Joelix_vsMatrix M)
+{
+  struct Joelix_sparse_Matrix_t *G = M->global;
+  int anfang, ende, i, j, k, spalte, nnz_diag, nnz_offd, nnz;
+  int *gefunden;
+
+  anfang = M->anfaenge[M->rang];
+  ende = anfang + M->nlokal;
+
+  /* Alle nicht-null Werte muessen eingetragen sein */
+  if (!joelix_smatrix_ist_befuellt (G)) return F_FALSCHE_ANZAHL_NICHT_NULL_WERTE;
+  if (G->nnE == 0) {
+    for (i = 0;i < G->n + 1;i++) G->zeilen_akk[i] = 0;
+  }
+  nnz = G->nnE;
+
+  /* 1. Sammle alle Spalten ausserhalb des eigenen Bereichs, sortiere sie und
+        entferne doppelte Eintraege. */
+  M->geist_global = malloc ((nnz > 0 ? nnz : 1) * sizeof (*M->geist_global));
+  if (M->geist_global == NULL) return F_KEIN_SPEICHER;
+  M->ngeist = 0;
+  for (k = 0;k < nnz;k++) {
+    spalte = G->spalten_ind[k];
+    if (spalte < 0 || spalte >= M->n) return F_FALSCHER_INDEX;
+    if (spalte < anfang || spalte >= ende) M->geist_global[M->ngeist++] = spalte;
+  }
+  qsort (M->geist_global, M->ngeist, sizeof (*M->geist_global), joelix_vergleiche_int);
+  for (i = 0, j = 0;i < M->ngeist;i++) {
+    if (j == 0 || M->geist_global[j-1] != M->geist_global[i]) M->geist_global[j++] = M->geist_global[i];
+  }
+  M->ngeist = j;
+  M->geist_werte = malloc ((M->ngeist > 0 ? M->ngeist : 1) * sizeof (*M->geist_werte));
+  if (M->geist_werte == NULL) return F_KEIN_SPEICHER;
+
+  /* 2. Spalte die Zeilen in einen lokalen und einen Geist-Teil auf */
+  nnz_offd = 0;
+  for (k = 0;k < nnz;k++) {
+    spalte = G->spalten_ind[k];
+    if (spalte < anfang || spalte >= ende) nnz_offd++;
+  }
+  nnz_diag = nnz - nnz_offd;
+  if (joelix_smatrix_init (&M->diag, M->nlokal, M->nlokal, nnz_diag) != F_ERFOLG
+      || joelix_smatrix_init (&M->offd, M->nlokal, M->ngeist, nnz_offd) != F_ERFOLG) {
+    return joelix_fehler_code;
+  }
+  M->diag->zeilen_akk[0] = M->offd->zeilen_akk[0] = 0;
+  nnz_diag = nnz_offd = 0;
+  for (i = 0;i < M->nlokal;i++) {
+    for (k = G->zeilen_akk[i];k < G->zeilen_akk[i+1];k++) {
+      spalte = G->spalten_ind[k];
+      if (spalte >= anfang && spalte < ende) {
+        M->diag->werte[nnz_diag] = G->werte[k];
+        M->diag->spalten_ind[nnz_diag++] = spalte - anfang;
+      }
+      else {
+        gefunden = bsearch (&spalte, M->geist_global, M->ngeist, sizeof (*M->geist_global),
+                            joelix_vergleiche_int);
+        M->offd->werte[nnz_offd] = G->werte[k];
+        M->offd->spalten_ind[nnz_offd++] = (int) (gefunden - M->geist_global);
+      }
+    }
+    M->diag->zeilen_akk[i+1] = nnz_diag;
+    M->offd->zeilen_akk[i+1] = nnz_offd;
+  }
+  M->diag->befuellt = M->offd->befuellt = 1;
+  M->empfang_rang = malloc (M->nraenge * sizeof (*M->empfang_rang));
+  M->empfang_anfang = malloc ((M->nraenge + 1) * sizeof (*M->empfang_anfang));
+  M->sende_rang = malloc (M->nraenge * sizeof (*M->sende_rang));
+  M->sende_anfang = malloc ((M->nraenge + 1) * sizeof (*M->sende_anfang));
+  if (M->empfang_rang == NULL || M->empfang_anfang == NULL || M->sende_rang == NULL
+      || M->sende_anfang == NULL) {
+    return F_KEIN_SPEICHER;
+  }
+  return F_ERFOLG;
+}
+
+/* Bestimme die Geistspalten und baue die Kommunikationsmuster auf. Vor jeder
+   kollektiven Operation einigen sich alle Raenge auf einen Fehler, so dass
+   alle Raenge denselben Code zurueckgeben. Bei einem Fehler wird alles
+   wieder abgebaut. */
+Joelix_Fehler joelix_vsmatrix_aufbauen (Joelix_vsMatrix M)
+{
+  int anfang, k, r, g, nsende_ind;
+  int *anzahl_empfang = NULL, *anzahl_sende = NULL, *versatz_sende = NULL;
+  int *versatz_empfang = NULL;
+  Joelix_Fehler fehler;
+
+  if (M == NULL || M->global == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  anfang = M->anfaenge[M->rang];
+
+  fehler = joelix_vsmatrix_lokal_aufbauen (M);
+  anzahl_empfang = calloc (M->nraenge, sizeof (*anzahl_empfang));
+  anzahl_sende = malloc (M->nraenge * sizeof (*anzahl_sende));
+  versatz_empfang = malloc ((M->nraenge + 1) * sizeof (*versatz_empfang));
+  versatz_sende = malloc ((M->nraenge + 1) * sizeof (*versatz_sende));
+  if (fehler == F_ERFOLG && (anzahl_empfang == NULL || anzahl_sende == NULL
+                             || versatz_empfang == NULL || versatz_sende == NULL)) {
+    fehler = F_KEIN_SPEICHER;
+  }
+  fehler = joelix_gemeinsamer_fehler (M->comm, fehler);
+  if (fehler != F_ERFOLG) goto aufraeumen;
+
+  /* 3. Empfangsmuster: Da geist_global sortiert ist und jeder Rang einen
+        zusammenhaengenden Bereich besitzt, liegen die Geisteintraege jedes
+        Nachbarn hintereinander. */
+  for (g = 0;g < M->ngeist;g++) anzahl_empfang[joelix_vsmatrix_besitzer (M, M->geist_global[g])]++;
+  M->nempfang = 0;
+  M->empfang_anfang[0] = 0;
+  for (r = 0;r < M->nraenge;r++) {
+    if (anzahl_empfang[r] > 0) {
+      M->empfang_rang[M->nempfang] = r;
+      M->empfang_anfang[M->nempfang + 1] = M->empfang_anfang[M->nempfang] + anzahl_empfang[r];
+      M->nempfang++;
+    }
+  }
+
+  /* 4. Sendemuster: Jeder Rang teilt seinen Nachbarn mit, welche globalen
+        Indices er von ihnen braucht. */
+  if (MPI_Alltoall (anzahl_empfang, 1, MPI_INT, anzahl_sende, 1, MPI_INT, M->comm) != MPI_SUCCESS) {
+    fehler = F_MPI_FEHLER;
+    goto aufraeumen;
+  }
+  versatz_empfang[0] = versatz_sende[0] = 0;
+  M->nsende = 0;
+  for (r = 0;r < M->nraenge;r++) {
+    versatz_empfang[r+1] = versatz_empfang[r] + anzahl_empfang[r];
+    versatz_sende[r+1] = versatz_sende[r] + anzahl_sende[r];
+    if (anzahl_sende[r] > 0) M->nsende++;
+  }
+  nsende_ind = versatz_sende[M->nraenge];
+  M->sende_ind = malloc ((nsende_ind > 0 ? nsende_ind : 1) * sizeof (*M->sende_ind));
+  M->sende_werte = malloc ((nsende_ind > 0 ? nsende_ind : 1) * sizeof (*M->sende_werte));
+  M->anfragen = malloc ((M->nempfang + M->nsende + 1) * sizeof (*M->anfragen));
+  if (M->sende_ind == NULL || M->sende_werte == NULL || M->anfragen == NULL) {
+    fehler = F_KEIN_SPEICHER;
+  }
+  fehler = joelix_gemeinsamer_fehler (M->comm, fehler);
+  if (fehler != F_ERFOLG) goto aufraeumen;
+  if (MPI_Alltoallv (M->geist_global, anzahl_empfang, versatz_empfang, MPI_INT,
+                     M->sende_ind, anzahl_sende, versatz_sende, MPI_INT, M->comm) != MPI_SUCCESS) {
+    fehler = F_MPI_FEHLER;
+    goto aufraeumen;
+  }
+  M->nsende = 0;
+  M->sende_anfang[0] = 0;
+  for (r = 0;r < M->nraenge;r++) {
+    if (anzahl_sende[r] > 0) {
+      M->sende_rang[M->nsende] = r;
+      M->sende_anfang[M->nsende + 1] = versatz_sende[r+1];
+      M->nsende++;
+    }
+  }
+  /* Umrechnen der angefragten globalen in lokale Indices */
+  for (k = 0;k < nsende_ind;k++) M->sende_ind[k] -= anfang;
+
+  /* Erst jetzt werden die Zeilen mit globalen Spalten nicht mehr gebraucht */
+  joelix_smatrix_loeschen (&M->global);
+  M->global = NULL;
+
+aufraeumen:
+  if (fehler != F_ERFOLG) joelix_vsmatrix_abbauen (M);
+  free (anzahl_empfang);
+  free (anzahl_sende);
+  free (versatz_empfang);
+  free (versatz_sende);
+  return (joelix_fehler_code = fehler);
+}
+
+/* b += A x bzw. b = A x fuer eine lokale CSR Matrix */
+static void joelix_vsmatrix_lokales_produkt (double *b, struct Joelix_sparse_Matrix_t *A,
+                                             const double *x, int addieren)
+{
+  int i, k;
+  double summe;
+
+  for (i = 0;i < A->n;i++) {
+    summe = addieren ? b[i] : 0;
+    for (k = A->zeilen_akk[i];k < A->zeilen_akk[i+1];k++) {
+      summe += A->werte[k] * x[A->spalten_ind[k]];
+    }
+    b[i] = summe;
+  }
+}
+
+/* b = Mx verteilt, Austausch und lokales Produkt ueberlappend */
+Joelix_Fehler joelix_vsmatvec (Joelix_vVektor b, Joelix_vsMatrix M, Joelix_vVektor x)
+{
+  Joelix_Fehler fehler = F_ERFOLG;
+  int i, k, q;
+  double *xw;
+
+  /* Ohne M ist der Kommunikator unbekannt */
+  if (b == NULL || M == NULL || x == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  if (M->diag == NULL || M->anfragen == NULL) {
+    fehler = F_FALSCHE_PARAMETER;
+  }
+  else if (x->lokal->laenge != M->nlokal || b->lokal->laenge != M->nlokal
+           || x->anfang != M->anfaenge[M->rang] || b->anfang != x->anfang) {
+    fehler = F_FALSCHE_DIMENSIONEN_MATRIX_VEKTOR;
+  }
+  /* Vor dem Austausch einigen, sonst warten die anderen Raenge in
+     MPI_Waitall auf diesen */
+  fehler = joelix_gemeinsamer_fehler (M->comm, fehler);
+  if (fehler != F_ERFOLG) return (joelix_fehler_code = fehler);
+  xw = x->lokal->werte;
+
+  /* Starte den Austausch der Geisteintraege */
+  q = 0;
+  for (i = 0;i < M->nempfang;i++) {
+    if (MPI_Irecv (M->geist_werte + M->empfang_anfang[i],
+                   M->empfang_anfang[i+1] - M->empfang_anfang[i], MPI_DOUBLE,
+                   M->empfang_rang[i], 0, M->comm, &M->anfragen[q++]) != MPI_SUCCESS) {
+      return (joelix_fehler_code = F_MPI_FEHLER);
+    }
+  }
+  for (i = 0;i < M->nsende;i++) {
+    for (k = M->sende_anfang[i];k < M->sende_anfang[i+1];k++) {
+      M->sende_werte[k] = xw[M->sende_ind[k]];
+    }
+    if (MPI_Isend (M->sende_werte + M->sende_anfang[i],
+                   M->sende_anfang[i+1] - M->sende_anfang[i], MPI_DOUBLE,
+                   M->sende_rang[i], 0, M->comm, &M->anfragen[q++]) != MPI_SUCCESS) {
+      return (joelix_fehler_code = F_MPI_FEHLER);
+    }
+  }
+
+  /* Waehrend die Nachrichten unterwegs sind, den lokalen Teil berechnen */
+  joelix_vsmatrix_lokales_produkt (b->lokal->werte, M->diag, xw, 0);
+
+  if (MPI_Waitall (q, M->anfragen, MPI_STATUSES_IGNORE) != MPI_SUCCESS) {
+    return (joelix_fehler_code = F_MPI_FEHLER);
+  }
+  /* Jetzt den Beitrag der Geistspalten addieren */
+  joelix_vsmatrix_lokales_produkt (b->lokal->werte, M->offd, M->geist_werte, 1);
+  return (joelix_fehler_code = F_ERFOLG);
+}
+
+/* Speicher einer verteilten Matrix freigeben */
+Joelix_Fehler joelix_vsmatrix_loeschen (Joelix_vsMatrix *pM)
+{
+  if (pM == NULL || *pM == NULL) return (joelix_fehler_code = F_FALSCHE_PARAMETER);
+  joelix_vsmatrix_befreien (*pM);
+  *pM = NULL;
+  return (joelix_fehler_code = F_ERFOLG);
+}